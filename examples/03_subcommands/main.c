@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include "argparse.h"
+
+// Calling from shell examples: 
+// ./03_subcommands commit --message "Fix typo" --amend
+// ./03_subcommands push --remote origin --branches main dev
+// ./03_subcommands --help
+
+int main(int argc, char** argv)
+{
+	Arg commit_args[] = {
+		[0].type     = ARG_STRING,
+		[0].flag     = "--message",
+		[0].required = true,
+		[0].nargs    = 1,
+		[0].help     = "The commit message",
+
+		[1].type     = ARG_BOOL,
+		[1].flag     = "--amend",
+		[1].help     = "Amend the previous commit",
+	};
+
+	Arg push_args[] = {
+		[0].type     = ARG_STRING,
+		[0].flag     = "--remote",
+		[0].required = true,
+		[0].nargs    = 1,
+		[0].help     = "The remote to push to",
+
+		[1].type     = ARG_STRING,
+		[1].flag     = "--branches",
+		[1].required = false,
+		[1].help     = "The branches to push (Could be more that 1)",
+	};
+
+	// Must be sorted by name
+	ArgCommand commands[] = {
+		{ .name = "commit", .args = commit_args, .args_size = 2, .help = "Record changes" },
+		{ .name = "push",   .args = push_args,   .args_size = 2, .help = "Update a remote" },
+	};
+
+	size_t commands_size = sizeof(commands)/sizeof(commands[0]);
+	ArgCommand* command = argParseCommand(argc, argv, commands, commands_size);
+
+	printf("command = %s\n", command->name);
+	for (size_t i = 0; i < command->args_size; i++) {
+		Arg a = command->args[i];
+		if (a.type == ARG_BOOL) {
+			printf("	%s = %d\n", a.flag, a.data.exists);
+		} else {
+			for (size_t j = 0; j < a.data.array_string.count; j++) {
+				printf("	%s = %s\n", a.flag, a.data.array_string.items[j]);
+			}
+		}
+	}
+}
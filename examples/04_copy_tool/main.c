@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include "argparse.h"
+
+// Positional arguments are declared with a flag that does not start with
+// "--" and are given in front of the first flag.
+//
+// Calling from shell examples: 
+// ./04_copy_tool a.txt b.txt c.txt backup/ --verbose
+// ./04_copy_tool a.txt backup/
+
+int main(int argc, char** argv)
+{
+	Arg args[] = {
+		[0].type     = ARG_STRING,
+		[0].flag     = "sources",
+		[0].required = true,
+		[0].nargs    = 0, // the one positional argument with nargs = inf takes the remaining values
+		[0].help     = "Files to copy",
+
+		[1].type     = ARG_STRING,
+		[1].flag     = "destination",
+		[1].nargs    = 1,
+		[1].help     = "Directory to copy the files to",
+
+		[2].type     = ARG_BOOL,
+		[2].flag     = "--verbose",
+		[2].help     = "Print every copied file",
+	};
+
+	size_t args_size = sizeof(args)/sizeof(args[0]);
+	argParse(argc, argv, args, args_size);
+
+	// The values point into argv, nothing is copied
+	Arg sources = args[0];
+	const char* destination = args[1].data.array_string.items[0];
+
+	for (size_t i = 0; i < sources.data.array_string.count; i++) {
+		if (args[2].data.exists) {
+			printf("%s -> %s\n", sources.data.array_string.items[i], destination);
+		}
+	}
+	printf("%zu files copied\n", sources.data.array_string.count);
+}
@@ -23,8 +23,13 @@
 #ifndef ARGPARSE_H_
 #define ARGPARSE_H_
 
+#include <assert.h>
 #include <stdio.h>
+#include <stddef.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
 
 typedef struct {
     char** items;
@@ -47,11 +52,117 @@ typedef struct {
 } ArrayOfDoubles;
 
 
+typedef struct {
+    int8_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfInt8s;
+
+
+typedef struct {
+    int16_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfInt16s;
+
+
+typedef struct {
+    int32_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfInt32s;
+
+
+typedef struct {
+    uint8_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfUint8s;
+
+
+typedef struct {
+    uint16_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfUint16s;
+
+
+typedef struct {
+    uint32_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfUint32s;
+
+
+typedef struct {
+    uint64_t* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfUint64s;
+
+
+typedef struct {
+    float* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfFloats;
+
+
+// Length delimited string, data is not NUL terminated.
+typedef struct {
+	const char* data;
+	size_t      size;
+} ArgSpan;
+
+
+typedef struct {
+    ArgSpan* items;
+    size_t count;
+    size_t capacity;
+} ArrayOfSpans;
+
+
+// ARG_STRING values of an argument declared with .intern. Each value is
+// an id into strings, which holds every distinct value once in order of
+// first appearance.
+typedef struct {
+    uint32_t*    items;
+    size_t       count;
+    size_t       capacity;
+    const char** strings;
+    size_t       strings_count;
+} ArgInterned;
+
+
+// ARG_LONG/ARG_DOUBLE values of an argument declared with .range and given
+// as one "first..last[:step]" token. They are generated on access: items
+// stays NULL and count is the number of values until argMaterialize.
+typedef struct {
+    void*  items;
+    size_t count;
+    size_t capacity;
+    union { long l; double d; } first;
+    union { long l; double d; } step;
+} ArgSequence;
+
+
 typedef union {
 	bool           exists;       // used for ARG_BOOL
 	ArrayOfStrings array_string; // used for ARG_STRING
 	ArrayOfLongs   array_long;   // used for ARG_LONG
 	ArrayOfDoubles array_double; // used for ARG_DOUBLE
+	ArrayOfInt8s   array_int8;   // used for ARG_INT8
+	ArrayOfInt16s  array_int16;  // used for ARG_INT16
+	ArrayOfInt32s  array_int32;  // used for ARG_INT32
+	ArrayOfUint8s  array_uint8;  // used for ARG_UINT8
+	ArrayOfUint16s array_uint16; // used for ARG_UINT16
+	ArrayOfUint32s array_uint32; // used for ARG_UINT32
+	ArrayOfUint64s array_uint64; // used for ARG_UINT64
+	ArrayOfFloats  array_float;  // used for ARG_FLOAT
+	ArrayOfInt32s  array_enum;   // used for ARG_ENUM, indices into .choices
+	ArrayOfSpans   array_span;   // used for ARG_STRING by argParseSpans
+	ArgInterned    interned;     // used for ARG_STRING with .intern
+	ArgSequence    sequence;     // used for ARG_LONG/ARG_DOUBLE with .range given a range
 } ArgData;
 
 
@@ -59,7 +170,16 @@ typedef enum {
 	ARG_BOOL,
 	ARG_STRING,
 	ARG_LONG,
-	ARG_DOUBLE
+	ARG_DOUBLE,
+	ARG_INT8,
+	ARG_INT16,
+	ARG_INT32,
+	ARG_UINT8,
+	ARG_UINT16,
+	ARG_UINT32,
+	ARG_UINT64,
+	ARG_FLOAT,
+	ARG_ENUM
 } ArgType;
 
 
@@ -68,8 +188,14 @@ typedef struct {
 	const char* flag;
 	ArgData     data;
 	bool        required;
+	bool        append; // repeated flags accumulate their values
+	bool        intern; // ARG_STRING values are stored as ids, see ArgInterned
+	bool        spans;  // set by argParseSpans: ARG_STRING values are in .data.array_span
+	bool        binary; // numeric values may be given as one "@bin:path" file
+	bool        range;  // ARG_LONG/ARG_DOUBLE accept one range, see ArgSequence
 	const char* help;
 	size_t      nargs;
+	const char* const* choices; // ARG_ENUM: NULL terminated names
 } Arg;
 
 
@@ -98,6 +224,29 @@ typedef struct {
        size_t    capacity;
 } ArgTokens;
 
+// Half open range [begin, end) of argv indices.
+typedef struct {
+	size_t begin;
+	size_t end;
+} ArgRange;
+
+
+typedef struct {
+	ArgRange* items;
+	size_t    count;
+	size_t    capacity;
+} ArgRanges;
+
+
+// What argParseKnown leaves to another parser, as argv index ranges: each
+// unknown flag together with the data tokens after it, and everything
+// after a "--". argCompactLeftovers moves them to the front of argv.
+typedef struct {
+	ArgRanges unknown;
+	ArgRange  remainder;
+	bool      separator; // whether "--" was given
+} ArgLeftovers;
+
 const char* argTypeToString(ArgType a);
 const char* argTokenTypeToString(ArgType a);
 bool        tokenizeArguments(int argc, char** argv, ArgTokens* tokens);
@@ -105,5 +254,368 @@ bool        parseFlagNargs(const ArgTokens* tokens, size_t* current_count, Args*
 bool        parseFlagBool(const ArgTokens* tokens, size_t* current_count, Args* args_parsed);
 bool        checkParsedArguments(const Args* args_parsed, Arg* args, size_t args_size);
 bool        argParse(int argc, char** argv, Arg* args, size_t args_size);
+bool        argParseKnown(int argc, char** argv, Arg* args, size_t args_size, ArgLeftovers* leftovers);
+int         argCompactLeftovers(int argc, char** argv, const ArgLeftovers* leftovers);
+void        argLeftoversFree(ArgLeftovers* leftovers);
+bool        argParseString(char* buffer, Arg* args, size_t args_size);
+bool        argParseSpans(const ArgSpan* spans, size_t count, Arg* args, size_t args_size);
+
+
+// Renders parsed arguments back into a NULL terminated argv, e.g. to
+// forward options to a child process. handles selects a subset (NULL for
+// all of them), program becomes argv[0] unless it is NULL. The strings
+// are the parsed ones, only numbers and the spans of argParseSpans are
+// written out, and everything lives in one allocation: release it with
+// free(argv->items) and do not grow it.
+bool        argUnparse(const char* program, const Arg* args, size_t args_size,
+                       const size_t* handles, size_t handles_count, ArrayOfStrings* argv);
+void        argSetParallelConversion(size_t threshold, size_t threads);
+bool        argParseFixed(int argc, char** argv, Arg* args, size_t args_size, void* buffer, size_t buffer_size);
+
+// Unmaps the numeric results given as "@bin:path" files.
+void        argUnmap(Arg* args, size_t args_size);
+
+// Expands a range kept as an ArgSequence into a regular array owned by
+// the caller. Other results are left alone.
+void        argMaterialize(Arg* args, size_t handle);
+
+
+// ARG_BOOL results packed one bit per declared argument, bit i belongs to
+// args[i]. The positions are the declaration indices, so they are known at
+// compile time and testing a flag is a single AND on one word.
+#define ARG_BITS_WORDS(args_size) (((size_t)(args_size) + 63) / 64)
+#define ARG_BIT(i)                ((uint64_t)1 << ((size_t)(i) % 64))
+#define ARG_BIT_TEST(bits, i)     (((bits)[(size_t)(i) / 64] & ARG_BIT(i)) != 0)
+
+void        argBoolBits(const Arg* args, size_t args_size, uint64_t* bits);
+
+
+typedef struct {
+	const char* flag;
+	size_t      index; // into ArgSchema.args
+} ArgSchemaEntry;
+
+
+#define ARG_ENUM_MAX_CHOICES 64
+
+// Perfect hash of the choices of an ARG_ENUM. A name hashes to a bucket
+// whose displacement picks its slot, so a lookup is one hash of the value
+// and one string compare. Slots hold the choice index + 1, 0 is empty.
+typedef struct {
+	const char* const* choices;
+	uint8_t            bucket_mask;
+	uint8_t            slot_mask;
+	uint8_t            displacement[ARG_ENUM_MAX_CHOICES];
+	uint8_t            slots[2 * ARG_ENUM_MAX_CHOICES];
+} ArgEnumHash;
+
+
+// Read-only index over a declared Arg[]. The flags are kept sorted next to
+// their declaration index, so lookups and prefix searches never touch the
+// Arg structs or their help strings. enums has the hash of each ARG_ENUM
+// at its declaration index, it is NULL when none is declared.
+typedef struct {
+	const Arg*      args;
+	size_t          args_size;
+	ArgSchemaEntry* sorted;
+	ArgEnumHash*    enums;
+} ArgSchema;
+
+
+// Result of argComplete. items are the candidate flags and the matching
+// choices of an ARG_ENUM, value_of is the declared argument whose value is
+// being typed (NULL when none is).
+typedef struct {
+	const char** items;
+	size_t       count;
+	size_t       capacity;
+	const Arg*   value_of;
+} ArgCompletions;
+
+bool   argSchemaCompile(ArgSchema* schema, const Arg* args, size_t args_size);
+void   argSchemaFree(ArgSchema* schema);
+size_t argSchemaFind(const ArgSchema* schema, const char* flag);
+size_t argSchemaHandle(const ArgSchema* schema, const char* flag);
+size_t argCount(const Arg* args, size_t handle);
+void   argComplete(const ArgSchema* schema, int argc, char** argv, size_t cursor, ArgCompletions* completions);
+void   argCompleteCommand(const Arg* args, size_t args_size, int argc, char** argv);
+
+
+// Typed access through a handle from argSchemaHandle, which is the
+// declaration index of the flag and stays valid for every parse of the
+// same Arg[]. Resolve handles once at startup, the accessors are plain
+// array indexing. The type and bounds are only checked by assert.
+static inline bool argBool(const Arg* args, size_t handle)
+{
+	assert(args[handle].type == ARG_BOOL);
+	return args[handle].data.exists;
+}
+
+
+// Spans from argParseSpans are not NUL terminated, read them with argSpan.
+static inline const char* argStr(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_STRING && !args[handle].spans && i < argCount(args, handle));
+	if (args[handle].intern) return args[handle].data.interned.strings[args[handle].data.interned.items[i]];
+	return args[handle].data.array_string.items[i];
+}
+
+
+// ARG_STRING values of every parser as spans.
+static inline ArgSpan argSpan(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_STRING && i < argCount(args, handle));
+	if (args[handle].spans) return args[handle].data.array_span.items[i];
+	const char* str = argStr(args, handle, i);
+	return (ArgSpan){ str, strlen(str) };
+}
+
+
+static inline uint32_t argId(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_STRING && args[handle].intern && i < args[handle].data.interned.count);
+	return args[handle].data.interned.items[i];
+}
+
+
+static inline long argLong(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_LONG && i < args[handle].data.array_long.count);
+	const ArgSequence* s = &args[handle].data.sequence;
+	if (args[handle].range && s->items == NULL) return (long)((unsigned long)s->first.l + (unsigned long)i * (unsigned long)s->step.l);
+	return args[handle].data.array_long.items[i];
+}
+
+
+static inline double argDouble(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_DOUBLE && i < args[handle].data.array_double.count);
+	const ArgSequence* s = &args[handle].data.sequence;
+	if (args[handle].range && s->items == NULL) return s->first.d + (double)i * s->step.d;
+	return args[handle].data.array_double.items[i];
+}
+
+
+// Index of the i-th value in .choices, ready for a switch.
+static inline int32_t argEnum(const Arg* args, size_t handle, size_t i)
+{
+	assert(args[handle].type == ARG_ENUM && i < args[handle].data.array_enum.count);
+	return args[handle].data.array_enum.items[i];
+}
+
+
+// A subcommand of a git-style tool. Tables of ArgCommand must be sorted by
+// name: the command is found by binary search and only its Arg[] is
+// compiled and parsed.
+typedef struct {
+	const char* name;
+	Arg*        args;
+	size_t      args_size;
+	const char* help;
+	ArgSchema   schema;   // compiled on first use
+	bool        compiled;
+} ArgCommand;
+
+const ArgSchema* argCommandSchema(ArgCommand* command);
+ArgCommand*      argCommandFind(ArgCommand* commands, size_t commands_size, const char* name);
+ArgCommand*      argParseCommand(int argc, char** argv, ArgCommand* commands, size_t commands_size);
+
+
+typedef enum {
+	ARG_ERROR_NONE,
+	ARG_ERROR_UNDECLARED,    // flag not declared in the Arg[]
+	ARG_ERROR_DUPLICATE,     // flag provided more than once
+	ARG_ERROR_MISSING,       // required flag not provided
+	ARG_ERROR_TYPE_MISMATCH, // ARG_BOOL flag with data or other flag without data
+	ARG_ERROR_NARGS,         // number of data tokens does not match .nargs
+	ARG_ERROR_VALUE,         // data token is not a valid number of the declared type
+	ARG_ERROR_STRAY_DATA     // data tokens before the first flag do not fit the positionals
+} ArgErrorKind;
+
+
+#define ARG_NO_TOKEN ((size_t)-1)
+
+typedef struct {
+	ArgErrorKind kind;
+	const char*  flag;  // NULL for ARG_ERROR_STRAY_DATA
+	size_t       token; // offending token index or ARG_NO_TOKEN
+} ArgError;
+
+
+typedef struct {
+	ArgError* items;
+	size_t    count;
+	size_t    capacity;
+} ArgErrors;
+
+
+// A token of an ArgParseState. Entries of type ARG_TOKEN_FLAG also carry
+// the validation result of their group: the flag plus the data tokens
+// that follow it.
+typedef struct {
+	ArgToken     token;
+	size_t       declared;     // index into the Arg[] or ARG_NO_TOKEN
+	ArgErrorKind error;
+	size_t       error_offset; // offending token relative to the flag
+} ArgStateToken;
+
+
+// Tokens of an edited command line kept in a gap buffer, so an edit costs
+// the size of the flag groups it touches plus the distance to the previous
+// edit, not the length of the line. Error counts are kept up to date per
+// edit, the token strings are borrowed like argv.
+typedef struct {
+	const Arg*     args;
+	size_t         args_size;
+	ArgSchema      schema;
+	ArgStateToken* items;
+	size_t         capacity;
+	size_t         gap_start;
+	size_t         gap_end;
+	size_t*        occurrences;  // per declared flag
+	size_t         group_errors;
+	size_t         duplicates;
+	size_t         missing;
+	size_t         stray;        // data tokens before the first flag
+	size_t         stray_value;  // first of them that is not a valid value, or ARG_NO_TOKEN
+	size_t         stray_owner;  // declaration of the positional it belongs to
+	size_t         positional_fixed;
+	const Arg*     positional_variadic;
+} ArgParseState;
+
+const char* argErrorKindToString(ArgErrorKind kind);
+bool        argParseStateInit(ArgParseState* state, const Arg* args, size_t args_size);
+void        argParseStateFree(ArgParseState* state);
+bool        argParseStateEdit(ArgParseState* state, size_t position, size_t remove_count,
+                              const char** insert, size_t insert_count);
+size_t      argParseStateCount(const ArgParseState* state);
+const char* argParseStateToken(const ArgParseState* state, size_t i);
+size_t      argParseStateErrorCount(const ArgParseState* state);
+void        argParseStateErrors(const ArgParseState* state, ArgErrors* errors);
+
+
+// Position independent image of a parsed Arg[]. Every reference is a byte
+// offset from the start of the blob, so it can be written into a memfd or
+// shared memory segment and read in place by any process mapping it.
+//
+//     ArgBlobHeader | ArgBlobEntry[args_size] | values | string bytes
+//
+// Values are arrays of the C type of numeric arguments (long[] for
+// ARG_LONG, uint8_t[] for ARG_UINT8, ...) and uint64_t[] string offsets
+// for ARG_STRING.
+#define ARG_BLOB_MAGIC   0x42475241u // "ARGB"
+#define ARG_BLOB_VERSION 1u
+
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint64_t args_size;
+	uint64_t reserved;
+} ArgBlobHeader;
+
+
+typedef struct {
+	uint32_t type;     // ArgType
+	uint32_t exists;   // ARG_BOOL value
+	uint64_t flag;     // offset of the flag string
+	uint64_t count;    // number of values
+	uint64_t values;   // offset of the values
+	uint64_t reserved;
+} ArgBlobEntry;
+
+// argBlobSize is 0, and argBlobWrite writes nothing, when the blob would
+// not fit in a size_t.
+size_t        argBlobSize(const Arg* args, size_t args_size);
+size_t        argBlobWrite(const Arg* args, size_t args_size, void* buffer, size_t buffer_size);
+bool          argBlobValidate(const void* blob, size_t size);
+size_t        argBlobArgsSize(const void* blob);
+const char*   argBlobFlag(const void* blob, size_t i);
+ArgType       argBlobType(const void* blob, size_t i);
+bool          argBlobExists(const void* blob, size_t i);
+size_t        argBlobCount(const void* blob, size_t i);
+const long*   argBlobLongs(const void* blob, size_t i);
+const double* argBlobDoubles(const void* blob, size_t i);
+const void*   argBlobValues(const void* blob, size_t i);
+const char*   argBlobString(const void* blob, size_t i, size_t j);
+
+
+// Buffer size argParseFixed needs for argc arguments and args_size declared
+// ones. It is a compile time constant for constant inputs, so the buffer
+// can be static.
+#define ARG_PARSE_FIXED_SIZE(argc, args_size)                                  \
+	(((size_t)(argc) + 1) * (sizeof(ArgToken) + sizeof(Arg) + 3 * sizeof(char*) + \
+	                         sizeof(size_t) + sizeof(long) + sizeof(double) +      \
+	                         5 * sizeof(uint32_t)) +                               \
+	 ((size_t)(args_size) + 7) * (sizeof(ArgSchemaEntry) + sizeof(size_t) +       \
+	                              sizeof(ArgEnumHash) + _Alignof(max_align_t)))
+
+
+// Reusable storage for parsing many command lines, e.g. one per request.
+// The buffer only grows, so once it has seen the largest input shape a
+// parse performs no allocation. Results point into the buffer and stay
+// valid until the next parse with the same context.
+typedef struct {
+	void*  buffer;
+	size_t size;
+} ArgParseContext;
+
+bool argParseContextParse(ArgParseContext* ctx, int argc, char** argv, Arg* args, size_t args_size);
+void argParseContextFree(ArgParseContext* ctx);
+
+
+// Immutable copy of a parsed Arg[] (schema and values) held in a single
+// allocation, so it no longer depends on argv or on the Arg[] that
+// argParse mutates.
+typedef struct {
+	Arg*      args;
+	size_t    args_size;
+	uint64_t* bits; // argBoolBits of args, ARG_BITS_WORDS(args_size) words
+} ArgSnapshot;
+
+
+#define ARG_SNAPSHOT_IDLE ((size_t)-1)
+
+// One slot per reader thread. It holds the epoch the reader entered at
+// or ARG_SNAPSHOT_IDLE. Padded to a cache line so readers do not share.
+typedef struct {
+	_Atomic size_t epoch;
+	char           pad[64 - sizeof(size_t)];
+} ArgSnapshotReader;
+
+
+typedef struct {
+	ArgSnapshot* snapshot;
+	size_t       epoch;
+} ArgRetiredSnapshot;
+
+
+typedef struct {
+	ArgRetiredSnapshot* items;
+	size_t              count;
+	size_t              capacity;
+} ArgRetiredSnapshots;
+
+
+// Publication point for snapshots. Readers never block, publishing is
+// expected to be done by one writer at a time.
+typedef struct {
+	_Atomic(ArgSnapshot*) current;
+	_Atomic size_t        epoch;
+	ArgSnapshotReader*    readers;
+	size_t                readers_count;
+	_Atomic size_t        readers_used;
+	ArgRetiredSnapshots   retired;
+} ArgSnapshotCell;
+
+ArgSnapshot*       argSnapshotCreate(const Arg* args, size_t args_size);
+void               argSnapshotFree(ArgSnapshot* snapshot);
+bool               argSnapshotCellInit(ArgSnapshotCell* cell, size_t max_readers);
+void               argSnapshotCellFree(ArgSnapshotCell* cell);
+void               argSnapshotPublish(ArgSnapshotCell* cell, ArgSnapshot* snapshot);
+size_t             argSnapshotReclaim(ArgSnapshotCell* cell);
+ArgSnapshotReader* argSnapshotReaderRegister(ArgSnapshotCell* cell);
+const ArgSnapshot* argSnapshotReadBegin(ArgSnapshotCell* cell, ArgSnapshotReader* reader);
+void               argSnapshotReadEnd(ArgSnapshotReader* reader);
 
 #endif // ARGPARSE_H_
@@ -0,0 +1,129 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A numeric flag declared with .binary and given "@bin:path" as its only
+// value takes the raw little endian elements of the file as its array,
+// mapped copy on write: nothing is parsed or copied and writes stay
+// private to the process. The mapping is the result, capacity 0 tells it
+// apart from allocated arrays. Other flags take "@bin:path" as a value,
+// so a command line built from untrusted input cannot open files.
+
+#define BIN_PREFIX "@bin:"
+
+bool argIsBinValue(const char* value)
+{
+	return !strncmp(value, BIN_PREFIX, sizeof(BIN_PREFIX) - 1);
+}
+
+
+bool argMapBinary(Arg* arg, const char* parsed_flag, const char* value)
+{
+	const char* path = value + sizeof(BIN_PREFIX) - 1;
+	size_t      size = argTypeSize(arg->type);
+	if (arg->type == ARG_ENUM) {
+		argLogError("Argument %s of type ARG_ENUM does not accept %s", parsed_flag, value);
+		return 1;
+	}
+#ifdef _WIN32
+	(void)path;
+	(void)size;
+	argLogError("Binary values like %s for %s are not supported on this platform", value, parsed_flag);
+	return 1;
+#else
+	const uint16_t one = 1;
+	if (*(const uint8_t*)&one != 1) {
+		argLogError("Binary values like %s for %s need a little endian host", value, parsed_flag);
+		return 1;
+	}
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		argLogError("Could not open %s given to %s: %s", path, parsed_flag, strerror(errno));
+		return 1;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		argLogError("%s given to %s is not a regular file", path, parsed_flag);
+		close(fd);
+		return 1;
+	}
+	if ((uint64_t)st.st_size % size != 0) {
+		argLogError("Size of %s given to %s is %lld bytes, not a multiple of the %zu bytes of %s",
+				path, parsed_flag, (long long)st.st_size, size, argTypeToString(arg->type));
+		close(fd);
+		return 1;
+	}
+
+	size_t count = (size_t)st.st_size / size;
+	void*  items = NULL;
+	if (count > 0) {
+		items = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (items == MAP_FAILED) {
+			argLogError("Could not map %s given to %s: %s", path, parsed_flag, strerror(errno));
+			close(fd);
+			return 1;
+		}
+		// Mappings are page aligned, this only guards odd platforms
+		ARG_ASSERT((uintptr_t)items % size == 0);
+	}
+	close(fd);
+
+	if (arg->nargs > 0 && count != arg->nargs) {
+		argLogError("Declared argument with flag %s and nargs %zu does not match the %zu values of %s",
+				arg->flag, arg->nargs, count, path);
+		if (items != NULL) munmap(items, count * size);
+		return 1;
+	}
+	argSetNumbers(arg, items, count, 0);
+	return 0;
+#endif
+}
+
+
+void argUnmap(Arg* args, size_t args_size)
+{
+	for (size_t i = 0; i < args_size; i++) {
+		if (!args[i].binary || !argIsNumeric(args[i].type)) continue;
+		size_t count, capacity;
+		void*  items = argNumbers(&args[i], &count, &capacity);
+		if (items == NULL || count == 0 || capacity != 0) continue;
+#ifndef _WIN32
+		munmap(items, count * argTypeSize(args[i].type));
+#endif
+		argSetNumbers(&args[i], NULL, 0, 0);
+	}
+}
@@ -0,0 +1,249 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+static size_t alignUp(size_t n, size_t alignment)
+{
+	return (n + alignment - 1) / alignment * alignment;
+}
+
+
+static size_t blobValueSize(ArgType type)
+{
+	if (type == ARG_STRING) return sizeof(uint64_t);
+	return argTypeSize(type);
+}
+
+
+static size_t blobValueCount(const Arg* arg)
+{
+	if (arg->type == ARG_BOOL) return 0;
+	return argCount(arg, 0);
+}
+
+
+// *total += count * size, false when it does not fit in a size_t
+static bool blobAdd(size_t* total, size_t count, size_t size)
+{
+	if (size > 0 && count > (SIZE_MAX - *total) / size) return false;
+	*total += count * size;
+	return true;
+}
+
+
+static bool blobAlign(size_t* total)
+{
+	if (*total > SIZE_MAX - 7) return false;
+	*total = alignUp(*total, 8);
+	return true;
+}
+
+
+static const ArgBlobEntry* blobEntry(const void* blob, size_t i)
+{
+	return (const ArgBlobEntry*)((const char*)blob + sizeof(ArgBlobHeader)) + i;
+}
+
+
+size_t argBlobSize(const Arg* args, size_t args_size)
+{
+	// The layout argBlobWrite fills in, with every step checked: a range
+	// can stand for more values than the address space holds.
+	size_t size = sizeof(ArgBlobHeader);
+	bool   fits = blobAdd(&size, args_size, sizeof(ArgBlobEntry));
+	for (size_t i = 0; fits && i < args_size; i++) {
+		fits = blobAlign(&size) && blobAdd(&size, blobValueCount(&args[i]), blobValueSize(args[i].type));
+	}
+	for (size_t i = 0; fits && i < args_size; i++) {
+		fits = blobAdd(&size, strlen(args[i].flag), 1) && blobAdd(&size, 1, 1);
+		for (size_t j = 0; fits && args[i].type == ARG_STRING && j < argCount(args, i); j++) {
+			fits = blobAdd(&size, argSpan(args, i, j).size, 1) && blobAdd(&size, 1, 1);
+		}
+	}
+	if (!fits || !blobAlign(&size)) {
+		argLogError("Blob of %zu arguments does not fit in the address space", args_size);
+		return 0;
+	}
+	return size;
+}
+
+
+size_t argBlobWrite(const Arg* args, size_t args_size, void* buffer, size_t buffer_size)
+{
+	// The offsets below can not overflow once the size did not
+	size_t size = argBlobSize(args, args_size);
+	if (size == 0) return 0;
+	if (size > buffer_size) {
+		argLogError("Blob of %zu bytes does not fit in a buffer of %zu bytes", size, buffer_size);
+		return 0;
+	}
+
+	char* base = buffer;
+	memset(base, 0, size);
+	ArgBlobHeader* header = (ArgBlobHeader*)base;
+	header->magic     = ARG_BLOB_MAGIC;
+	header->version   = ARG_BLOB_VERSION;
+	header->size      = size;
+	header->args_size = args_size;
+
+	ArgBlobEntry* entries = (ArgBlobEntry*)(base + sizeof(ArgBlobHeader));
+	size_t values = sizeof(ArgBlobHeader) + args_size * sizeof(ArgBlobEntry);
+	for (size_t i = 0; i < args_size; i++) {
+		values = alignUp(values, 8);
+		entries[i].type   = args[i].type;
+		entries[i].count  = blobValueCount(&args[i]);
+		entries[i].values = values;
+		values += entries[i].count * blobValueSize(args[i].type);
+	}
+
+	size_t bytes = values;
+	for (size_t i = 0; i < args_size; i++) {
+		const Arg* arg = &args[i];
+		ArgBlobEntry* e = &entries[i];
+
+		size_t n = strlen(arg->flag) + 1;
+		memcpy(base + bytes, arg->flag, n);
+		e->flag = bytes;
+		bytes += n;
+
+		if (arg->type == ARG_BOOL) {
+			e->exists = arg->data.exists;
+		} else if (argIsNumeric(arg->type) && e->count > 0) {
+			argCopyNumbers(arg, base + e->values);
+		} else if (arg->type == ARG_STRING) {
+			uint64_t* offsets = (uint64_t*)(base + e->values);
+			for (size_t j = 0; j < e->count; j++) {
+				// The buffer is zeroed, which terminates spans
+				ArgSpan value = argSpan(arg, 0, j);
+				memcpy(base + bytes, value.data, value.size);
+				offsets[j] = bytes;
+				bytes += value.size + 1;
+			}
+		}
+	}
+	return size;
+}
+
+
+static bool blobStringValid(const char* base, size_t size, uint64_t offset)
+{
+	return offset < size && memchr(base + offset, '\0', size - offset) != NULL;
+}
+
+
+bool argBlobValidate(const void* blob, size_t size)
+{
+	const char* base = blob;
+	const ArgBlobHeader* header = blob;
+	// Every bound is a division or a subtraction from a smaller value, so a
+	// hostile header can not make the checks themselves wrap.
+	if (size < sizeof(ArgBlobHeader) ||
+	    header->magic != ARG_BLOB_MAGIC ||
+	    header->version != ARG_BLOB_VERSION ||
+	    header->size < sizeof(ArgBlobHeader) ||
+	    header->size > size ||
+	    header->args_size > (header->size - sizeof(ArgBlobHeader)) / sizeof(ArgBlobEntry)) {
+		argLogError("Invalid argument blob header");
+		return false;
+	}
+
+	size = (size_t)header->size;
+	for (size_t i = 0; i < header->args_size; i++) {
+		const ArgBlobEntry* e = blobEntry(blob, i);
+		if (e->type > ARG_ENUM ||
+		    !blobStringValid(base, size, e->flag) ||
+		    e->values % 8 != 0 ||
+		    e->values > size ||
+		    (blobValueSize(e->type) > 0 && e->count > (size - e->values) / blobValueSize(e->type))) {
+			argLogError("Invalid argument blob entry %zu", i);
+			return false;
+		}
+		if (e->type != ARG_STRING) continue;
+
+		const uint64_t* offsets = (const uint64_t*)(base + e->values);
+		for (size_t j = 0; j < e->count; j++) {
+			if (!blobStringValid(base, size, offsets[j])) {
+				argLogError("Invalid argument blob string %zu of entry %zu", j, i);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+size_t argBlobArgsSize(const void* blob)
+{
+	return ((const ArgBlobHeader*)blob)->args_size;
+}
+
+
+const char* argBlobFlag(const void* blob, size_t i)
+{
+	return (const char*)blob + blobEntry(blob, i)->flag;
+}
+
+
+ArgType argBlobType(const void* blob, size_t i)
+{
+	return (ArgType)blobEntry(blob, i)->type;
+}
+
+
+bool argBlobExists(const void* blob, size_t i)
+{
+	return blobEntry(blob, i)->exists;
+}
+
+
+size_t argBlobCount(const void* blob, size_t i)
+{
+	return blobEntry(blob, i)->count;
+}
+
+
+const long* argBlobLongs(const void* blob, size_t i)
+{
+	return (const long*)((const char*)blob + blobEntry(blob, i)->values);
+}
+
+
+const double* argBlobDoubles(const void* blob, size_t i)
+{
+	return (const double*)((const char*)blob + blobEntry(blob, i)->values);
+}
+
+
+const void* argBlobValues(const void* blob, size_t i)
+{
+	return (const char*)blob + blobEntry(blob, i)->values;
+}
+
+
+const char* argBlobString(const void* blob, size_t i, size_t j)
+{
+	const uint64_t* offsets = (const uint64_t*)((const char*)blob + blobEntry(blob, i)->values);
+	return (const char*)blob + offsets[j];
+}
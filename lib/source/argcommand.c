@@ -0,0 +1,112 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+static void displayCommands(const ArgCommand* commands, size_t commands_size)
+{
+	printf("Help: Declared commands:\n");
+	for (size_t i = 0; i < commands_size; i++) {
+		printf("    %s", commands[i].name);
+		if (commands[i].help != NULL) printf(": %s", commands[i].help);
+		printf("\n");
+	}
+}
+
+
+static size_t commandLowerBound(const ArgCommand* commands, size_t commands_size, const char* name, size_t n)
+{
+	size_t lo = 0;
+	size_t hi = commands_size;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		int cmp = (n == (size_t)-1) ? strcmp(commands[mid].name, name) : strncmp(commands[mid].name, name, n);
+		if (cmp < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+
+const ArgSchema* argCommandSchema(ArgCommand* command)
+{
+	if (!command->compiled) {
+		if (argSchemaCompile(&command->schema, command->args, command->args_size)) exit(1);
+		command->compiled = true;
+	}
+	return &command->schema;
+}
+
+
+ArgCommand* argCommandFind(ArgCommand* commands, size_t commands_size, const char* name)
+{
+	size_t i = commandLowerBound(commands, commands_size, name, (size_t)-1);
+	if (i < commands_size && !strcmp(commands[i].name, name)) return &commands[i];
+
+	// A miss is the error path, only then pay for checking the table order.
+	for (size_t j = 1; j < commands_size; j++) {
+		if (strcmp(commands[j - 1].name, commands[j].name) >= 0) {
+			argLogError("Commands %s and %s are not declared sorted by name", commands[j - 1].name, commands[j].name);
+			exit(1);
+		}
+	}
+	return NULL;
+}
+
+
+ArgCommand* argParseCommand(int argc, char** argv, ArgCommand* commands, size_t commands_size)
+{
+	if (argc > 1 && !strcmp(argv[1], "__complete")) {
+		if (argc <= 3) {
+			const char* prefix = (argc == 3) ? argv[2] : "";
+			size_t n = strlen(prefix);
+			for (size_t i = commandLowerBound(commands, commands_size, prefix, n); i < commands_size; i++) {
+				if (strncmp(commands[i].name, prefix, n) != 0) break;
+				printf("%s\n", commands[i].name);
+			}
+			exit(0);
+		}
+		ArgCommand* command = argCommandFind(commands, commands_size, argv[2]);
+		if (command == NULL) exit(0);
+		argCompleteSchema(argCommandSchema(command), argc - 2, argv + 2);
+	}
+
+	if (argc < 2 || !strcmp(argv[1], "--help")) {
+		displayCommands(commands, commands_size);
+		exit(argc < 2);
+	}
+
+	ArgCommand* command = argCommandFind(commands, commands_size, argv[1]);
+	if (command == NULL) {
+		argLogError("Undeclared command %s provided", argv[1]);
+		exit(1);
+	}
+
+	argParseCompiled(argc - 1, argv + 1, command->args, argCommandSchema(command));
+	return command;
+}
@@ -0,0 +1,105 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+static void completeFlags(const ArgSchema* schema, const char* prefix, ArgCompletions* completions)
+{
+	size_t n = strlen(prefix);
+	for (size_t i = argSchemaLowerBound(schema, prefix, n); i < schema->args_size; i++) {
+		if (strncmp(schema->sorted[i].flag, prefix, n) != 0) break;
+		if (argIsPositional(&schema->args[schema->sorted[i].index])) continue;
+		ARG_DA_APPEND(completions, schema->sorted[i].flag);
+	}
+}
+
+
+static void completeChoices(const Arg* arg, const char* prefix, ArgCompletions* completions)
+{
+	size_t n = strlen(prefix);
+	for (const char* const* c = arg->choices; c != NULL && *c != NULL; c++) {
+		if (strncmp(*c, prefix, n) == 0) ARG_DA_APPEND(completions, *c);
+	}
+}
+
+
+void argComplete(const ArgSchema* schema, int argc, char** argv, size_t cursor, ArgCompletions* completions)
+{
+	completions->count    = 0;
+	completions->value_of = NULL;
+	if (cursor == 0) return;
+
+	const char* word = (cursor < (size_t)argc) ? argv[cursor] : "";
+	if (argClassifyToken(word) == ARG_TOKEN_FLAG || word[0] == '-') {
+		completeFlags(schema, word, completions);
+		return;
+	}
+
+	// The word is data: find the flag it belongs to.
+	size_t owner = cursor;
+	while (owner > 1 && argClassifyToken(argv[owner - 1]) != ARG_TOKEN_FLAG) owner--;
+	owner--;
+
+	size_t declared = (owner >= 1) ? argSchemaFind(schema, argv[owner]) : ARG_NO_TOKEN;
+	size_t given    = cursor - owner - 1;
+	if (declared != ARG_NO_TOKEN) {
+		const Arg* arg = &schema->args[declared];
+		if (arg->type != ARG_BOOL && (arg->nargs == 0 || given < arg->nargs)) {
+			completions->value_of = arg;
+		}
+	}
+	if (completions->value_of != NULL && completions->value_of->type == ARG_ENUM) {
+		completeChoices(completions->value_of, word, completions);
+	}
+
+	// An empty word may also start the next flag once the current one has
+	// enough data.
+	if (word[0] == '\0' && (completions->value_of == NULL || (completions->value_of->nargs == 0 && given > 0))) {
+		completeFlags(schema, word, completions);
+	}
+}
+
+
+void argCompleteSchema(const ArgSchema* schema, int argc, char** argv)
+{
+	// argv[0] is "__complete", the word to complete is the last one.
+	ArgCompletions completions = {0};
+	size_t cursor = (argc > 1) ? (size_t)argc - 1 : 1;
+	argComplete(schema, argc, argv, cursor, &completions);
+	ARG_DA_FOREACH(const char*, c, &completions) {
+		printf("%s\n", *c);
+	}
+
+	ARG_DA_FREE(completions);
+	exit(0);
+}
+
+
+void argCompleteCommand(const Arg* args, size_t args_size, int argc, char** argv)
+{
+	ArgSchema schema;
+	if (argSchemaCompile(&schema, args, args_size)) exit(1);
+	argCompleteSchema(&schema, argc, argv);
+}
@@ -0,0 +1,375 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// Lists of at least ARG_CONVERT_THRESHOLD values are split in chunks
+// converted by up to ARG_CONVERT_THREADS threads (the caller included).
+#ifndef ARG_CONVERT_THRESHOLD
+#define ARG_CONVERT_THRESHOLD 65536
+#endif
+
+#ifndef ARG_CONVERT_THREADS
+#define ARG_CONVERT_THREADS 4
+#endif
+
+#define ARG_CONVERT_MAX_THREADS 64
+
+static size_t convert_threshold = ARG_CONVERT_THRESHOLD;
+static size_t convert_threads   = ARG_CONVERT_THREADS;
+
+typedef struct {
+	ArgType            type;
+	const ArgEnumHash* choices;
+	char**             values;
+	void*              dst;
+	size_t             begin;
+	size_t             end;
+	size_t             failed; // lowest invalid index of the chunk or end
+} ConvertChunk;
+
+
+bool argIsNumeric(ArgType type)
+{
+	return argTypeSize(type) > 0;
+}
+
+
+size_t argTypeSize(ArgType type)
+{
+	switch (type) {
+	case ARG_LONG:   return sizeof(long);
+	case ARG_DOUBLE: return sizeof(double);
+	case ARG_INT8:   return sizeof(int8_t);
+	case ARG_INT16:  return sizeof(int16_t);
+	case ARG_INT32:  return sizeof(int32_t);
+	case ARG_UINT8:  return sizeof(uint8_t);
+	case ARG_UINT16: return sizeof(uint16_t);
+	case ARG_UINT32: return sizeof(uint32_t);
+	case ARG_UINT64: return sizeof(uint64_t);
+	case ARG_FLOAT:  return sizeof(float);
+	case ARG_ENUM:   return sizeof(int32_t);
+	default:         return 0;
+	}
+}
+
+
+#define NUMBERS_GET(array)                          \
+	do {                                            \
+		if (count)    *count    = (array).count;    \
+		if (capacity) *capacity = (array).capacity; \
+		return (array).items;                       \
+	} while (0)
+
+void* argNumbers(const Arg* arg, size_t* count, size_t* capacity)
+{
+	switch (arg->type) {
+	case ARG_LONG:   NUMBERS_GET(arg->data.array_long);
+	case ARG_DOUBLE: NUMBERS_GET(arg->data.array_double);
+	case ARG_INT8:   NUMBERS_GET(arg->data.array_int8);
+	case ARG_INT16:  NUMBERS_GET(arg->data.array_int16);
+	case ARG_INT32:  NUMBERS_GET(arg->data.array_int32);
+	case ARG_UINT8:  NUMBERS_GET(arg->data.array_uint8);
+	case ARG_UINT16: NUMBERS_GET(arg->data.array_uint16);
+	case ARG_UINT32: NUMBERS_GET(arg->data.array_uint32);
+	case ARG_UINT64: NUMBERS_GET(arg->data.array_uint64);
+	case ARG_FLOAT:  NUMBERS_GET(arg->data.array_float);
+	case ARG_ENUM:   NUMBERS_GET(arg->data.array_enum);
+	default:
+		argLogError("Argument %s of type %s has no numeric values", arg->flag, argTypeToString(arg->type));
+		exit(1);
+	}
+}
+
+
+#define NUMBERS_SET(array)             \
+	do {                               \
+		(array).items    = items;      \
+		(array).count    = count;      \
+		(array).capacity = capacity;   \
+		return;                        \
+	} while (0)
+
+void argSetNumbers(Arg* arg, void* items, size_t count, size_t capacity)
+{
+	switch (arg->type) {
+	case ARG_LONG:   NUMBERS_SET(arg->data.array_long);
+	case ARG_DOUBLE: NUMBERS_SET(arg->data.array_double);
+	case ARG_INT8:   NUMBERS_SET(arg->data.array_int8);
+	case ARG_INT16:  NUMBERS_SET(arg->data.array_int16);
+	case ARG_INT32:  NUMBERS_SET(arg->data.array_int32);
+	case ARG_UINT8:  NUMBERS_SET(arg->data.array_uint8);
+	case ARG_UINT16: NUMBERS_SET(arg->data.array_uint16);
+	case ARG_UINT32: NUMBERS_SET(arg->data.array_uint32);
+	case ARG_UINT64: NUMBERS_SET(arg->data.array_uint64);
+	case ARG_FLOAT:  NUMBERS_SET(arg->data.array_float);
+	case ARG_ENUM:   NUMBERS_SET(arg->data.array_enum);
+	default:
+		argLogError("Argument %s of type %s has no numeric values", arg->flag, argTypeToString(arg->type));
+		exit(1);
+	}
+}
+
+
+// Decimal digits of at most max, with overflow detection.
+static bool parseMagnitude(const char* str, const char* end, uint64_t max, uint64_t* out)
+{
+	if (str == end) return false;
+	uint64_t value = 0;
+	for (; str < end; str++) {
+		if (*str < '0' || *str > '9') return false;
+		uint64_t digit = (uint64_t)(*str - '0');
+		if (value > (max - digit) / 10) return false;
+		value = value * 10 + digit;
+	}
+	*out = value;
+	return true;
+}
+
+
+static bool parseSigned(const char* str, const char* end, int64_t min, int64_t max, int64_t* out)
+{
+	bool negative = str < end && *str == '-';
+	if (str < end && (*str == '-' || *str == '+')) str++;
+
+	uint64_t magnitude;
+	uint64_t limit = negative ? (uint64_t)(-(min + 1)) + 1 : (uint64_t)max;
+	if (!parseMagnitude(str, end, limit, &magnitude)) return false;
+	*out = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+	return true;
+}
+
+
+static bool parseUnsigned(const char* str, const char* end, uint64_t max, uint64_t* out)
+{
+	if (str < end && *str == '+') str++;
+	return parseMagnitude(str, end, max, out);
+}
+
+
+bool argConvertValue(ArgType type, const ArgEnumHash* choices, const char* str, void* dst)
+{
+	return argConvertSpan(type, choices, str, strlen(str), dst);
+}
+
+
+bool argConvertSpan(ArgType type, const ArgEnumHash* choices, const char* str, size_t size, void* dst)
+{
+	const char* end = str + size;
+	int64_t  i;
+	uint64_t u;
+	double   d;
+	switch (type) {
+	case ARG_LONG:
+		if (!parseSigned(str, end, LONG_MIN, LONG_MAX, &i)) return false;
+		*(long*)dst = (long)i;
+		return true;
+	case ARG_DOUBLE:
+		return argParseDouble(str, size, dst);
+	case ARG_INT8:
+		if (!parseSigned(str, end, INT8_MIN, INT8_MAX, &i)) return false;
+		*(int8_t*)dst = (int8_t)i;
+		return true;
+	case ARG_INT16:
+		if (!parseSigned(str, end, INT16_MIN, INT16_MAX, &i)) return false;
+		*(int16_t*)dst = (int16_t)i;
+		return true;
+	case ARG_INT32:
+		if (!parseSigned(str, end, INT32_MIN, INT32_MAX, &i)) return false;
+		*(int32_t*)dst = (int32_t)i;
+		return true;
+	case ARG_UINT8:
+		if (!parseUnsigned(str, end, UINT8_MAX, &u)) return false;
+		*(uint8_t*)dst = (uint8_t)u;
+		return true;
+	case ARG_UINT16:
+		if (!parseUnsigned(str, end, UINT16_MAX, &u)) return false;
+		*(uint16_t*)dst = (uint16_t)u;
+		return true;
+	case ARG_UINT32:
+		if (!parseUnsigned(str, end, UINT32_MAX, &u)) return false;
+		*(uint32_t*)dst = (uint32_t)u;
+		return true;
+	case ARG_UINT64:
+		if (!parseUnsigned(str, end, UINT64_MAX, &u)) return false;
+		*(uint64_t*)dst = u;
+		return true;
+	case ARG_FLOAT:
+		// Values from halfway between FLT_MAX and 2^128 up round to inf
+		if (!argParseDouble(str, size, &d)) return false;
+		if (isfinite(d) && fabs(d) >= 0x1.ffffffp127) return false;
+		*(float*)dst = (float)d;
+		return true;
+	case ARG_ENUM:
+		return choices != NULL && argEnumFind(choices, str, size, dst);
+	default:
+		return false;
+	}
+}
+
+
+static void convertRange(ConvertChunk* c)
+{
+	size_t size = argTypeSize(c->type);
+	char*  dst  = c->dst;
+	c->failed = c->end;
+	for (size_t i = c->begin; i < c->end; i++) {
+		if (!argConvertValue(c->type, c->choices, c->values[i], dst + i * size)) {
+			c->failed = i;
+			return;
+		}
+	}
+}
+
+
+#ifndef _WIN32
+// Workers are started on the first parallel conversion and then wait for
+// the next one, so a parse does not create threads for each list. One
+// conversion uses the pool at a time: the chunks of a job are taken by the
+// workers and the caller alike, and a caller that finds the pool busy
+// converts its list alone.
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t  wake; // a job was posted
+	pthread_cond_t  idle; // the last chunk of the job is done
+	size_t          started;
+	ConvertChunk*   chunks;
+	size_t          next;
+	size_t          count;
+	size_t          pending;
+} ConvertPool;
+
+static ConvertPool pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.wake = PTHREAD_COND_INITIALIZER,
+	.idle = PTHREAD_COND_INITIALIZER,
+};
+
+
+// Runs chunks of the posted job until none is left, with the lock held
+// on entry and on return.
+static void convertTakeChunks(void)
+{
+	while (pool.next < pool.count) {
+		ConvertChunk* chunk = &pool.chunks[pool.next++];
+		pthread_mutex_unlock(&pool.lock);
+		convertRange(chunk);
+		pthread_mutex_lock(&pool.lock);
+		if (--pool.pending == 0) pthread_cond_signal(&pool.idle);
+	}
+}
+
+
+static void* convertWorker(void* unused)
+{
+	(void)unused;
+	pthread_mutex_lock(&pool.lock);
+	for (;;) {
+		while (pool.next >= pool.count) pthread_cond_wait(&pool.wake, &pool.lock);
+		convertTakeChunks();
+	}
+	return NULL;
+}
+
+
+// Converts the chunks with the pool, false if it is busy.
+static bool convertPooled(ConvertChunk* chunks, size_t count)
+{
+	pthread_mutex_lock(&pool.lock);
+	if (pool.chunks != NULL) {
+		pthread_mutex_unlock(&pool.lock);
+		return false;
+	}
+
+	// A worker that cannot be started only leaves more chunks to the caller
+	while (pool.started < count - 1) {
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, convertWorker, NULL) != 0) break;
+		pthread_detach(worker);
+		pool.started++;
+	}
+
+	pool.chunks  = chunks;
+	pool.next    = 0;
+	pool.count   = count;
+	pool.pending = count;
+	pthread_cond_broadcast(&pool.wake);
+	convertTakeChunks();
+	while (pool.pending > 0) pthread_cond_wait(&pool.idle, &pool.lock);
+	pool.chunks = NULL;
+	pool.count  = 0;
+	pthread_mutex_unlock(&pool.lock);
+	return true;
+}
+#endif
+
+
+void argSetParallelConversion(size_t threshold, size_t threads)
+{
+	if (threads > ARG_CONVERT_MAX_THREADS) threads = ARG_CONVERT_MAX_THREADS;
+	convert_threshold = threshold;
+	convert_threads   = threads;
+}
+
+
+size_t argConvertNumbers(ArgType type, const ArgEnumHash* choices, char** values, size_t count, void* dst, bool parallel)
+{
+	size_t threads = parallel ? convert_threads : 1;
+#ifdef _WIN32
+	threads = 1;
+#endif
+	if (count < convert_threshold || threads < 2) {
+		ConvertChunk all = { .type = type, .choices = choices, .values = values, .dst = dst, .begin = 0, .end = count };
+		convertRange(&all);
+		return all.failed;
+	}
+
+	ConvertChunk chunks[ARG_CONVERT_MAX_THREADS];
+	size_t step = (count + threads - 1) / threads;
+	for (size_t t = 0; t < threads; t++) {
+		size_t begin = t * step < count ? t * step : count;
+		size_t end   = begin + step < count ? begin + step : count;
+		chunks[t] = (ConvertChunk){ .type = type, .choices = choices, .values = values, .dst = dst, .begin = begin, .end = end };
+	}
+
+#ifndef _WIN32
+	if (!convertPooled(chunks, threads)) {
+		for (size_t t = 0; t < threads; t++) convertRange(&chunks[t]);
+	}
+#endif
+
+	// Each chunk stops at its first error, the lowest one overall is the
+	// first chunk that failed.
+	for (size_t t = 0; t < threads; t++) {
+		if (chunks[t].failed < chunks[t].end) return chunks[t].failed;
+	}
+	return count;
+}
@@ -0,0 +1,98 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// The few dynamic array and logging primitives the library needs. They
+// used to come from nob.h, compiling all of it into the library and
+// exporting its nob_* symbols next to the ones of the program using it.
+
+#ifndef ARGCORE_H_
+#define ARGCORE_H_
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARG_ASSERT
+#define ARG_ASSERT assert
+#endif
+
+#ifndef ARG_REALLOC
+#define ARG_REALLOC realloc
+#endif
+
+#ifndef ARG_FREE
+#define ARG_FREE free
+#endif
+
+#define ARG_DA_INIT_CAP 256
+
+#define ARG_DA_RESERVE(da, expected_capacity)                                              \
+	do {                                                                                   \
+		if ((expected_capacity) > (da)->capacity) {                                        \
+			if ((da)->capacity == 0) (da)->capacity = ARG_DA_INIT_CAP;                     \
+			while ((expected_capacity) > (da)->capacity) (da)->capacity *= 2;              \
+			(da)->items = ARG_REALLOC((da)->items, (da)->capacity * sizeof(*(da)->items)); \
+			ARG_ASSERT((da)->items != NULL && "Buy more RAM lol");                         \
+		}                                                                                  \
+	} while (0)
+
+#define ARG_DA_APPEND(da, item)                 \
+	do {                                        \
+		ARG_DA_RESERVE((da), (da)->count + 1);  \
+		(da)->items[(da)->count++] = (item);    \
+	} while (0)
+
+#define ARG_DA_FREE(da) ARG_FREE((da).items)
+
+#define ARG_DA_FOREACH(Type, it, da) for (Type* it = (da)->items; it < (da)->items + (da)->count; ++it)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ARG_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define ARG_PRINTF_FORMAT(fmt, args)
+#endif
+
+// Static tracepoints of provider "argparse" for bpftrace/perf, e.g.
+// usdt:./prog:argparse:tokenize_start. With sys/sdt.h each one is a single
+// nop plus an ELF note, without it (or with ARG_NO_PROBES) they expand to
+// nothing and their arguments are not evaluated.
+#if !defined(ARG_NO_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define ARG_PROBES_ENABLED
+#define ARG_PROBE1(name, a)       DTRACE_PROBE1(argparse, name, a)
+#define ARG_PROBE2(name, a, b)    DTRACE_PROBE2(argparse, name, a, b)
+#define ARG_PROBE3(name, a, b, c) DTRACE_PROBE3(argparse, name, a, b, c)
+#endif
+#endif
+
+#ifndef ARG_PROBE1
+#define ARG_PROBE1(name, a)       do {} while (0)
+#define ARG_PROBE2(name, a, b)    do {} while (0)
+#define ARG_PROBE3(name, a, b, c) do {} while (0)
+#endif
+
+// Prints "[ERROR] <message>" on stderr
+void argLogError(const char* fmt, ...) ARG_PRINTF_FORMAT(1, 2);
+
+#endif // ARGCORE_H_
@@ -0,0 +1,151 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <stdint.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// Hash and displace: every name is hashed once, the bucket comes from the
+// hash mixed with seed 0 and the slot from the hash mixed with the bucket's
+// displacement. Buckets are filled largest first, trying displacements
+// until all names of the bucket land on free distinct slots.
+
+#define ENUM_MAX_DISPLACEMENT 255
+
+uint32_t argHashBytes(const char* str, size_t size)
+{
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < size; i++) {
+		h ^= (unsigned char)str[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+
+// FNV-1a alone leaves the low bits depending on the low bits of the
+// input only, the finalizer spreads every bit before masking.
+uint32_t argHashMix(uint32_t h, uint32_t seed)
+{
+	h ^= seed * 0x9e3779b9u;
+	h ^= h >> 16;
+	h *= 0x7feb352du;
+	h ^= h >> 15;
+	h *= 0x846ca68bu;
+	h ^= h >> 16;
+	return h;
+}
+
+
+bool argHasEnums(const Arg* args, size_t args_size)
+{
+	for (size_t i = 0; i < args_size; i++) {
+		if (args[i].type == ARG_ENUM) return true;
+	}
+	return false;
+}
+
+
+bool argEnumCompile(const Arg* arg, ArgEnumHash* hash)
+{
+	size_t n = 0;
+	while (arg->choices != NULL && arg->choices[n] != NULL) n++;
+	if (n == 0 || n > ARG_ENUM_MAX_CHOICES) {
+		argLogError("Argument %s of type ARG_ENUM needs between 1 and %d choices, got %zu", arg->flag, ARG_ENUM_MAX_CHOICES, n);
+		return 1;
+	}
+	for (size_t i = 1; i < n; i++) {
+		for (size_t j = 0; j < i; j++) {
+			if (!strcmp(arg->choices[i], arg->choices[j])) {
+				argLogError("Duplicate choice %s declared for argument %s", arg->choices[i], arg->flag);
+				return 1;
+			}
+		}
+	}
+
+	size_t slots = 2;
+	while (slots < 2 * n) slots *= 2;
+	size_t buckets = slots / 2;
+
+	memset(hash, 0, sizeof(*hash));
+	hash->choices     = arg->choices;
+	hash->slot_mask   = (uint8_t)(slots - 1);
+	hash->bucket_mask = (uint8_t)(buckets - 1);
+
+	uint32_t h[ARG_ENUM_MAX_CHOICES];
+	uint8_t  bucket_of[ARG_ENUM_MAX_CHOICES];
+	uint8_t  bucket_size[ARG_ENUM_MAX_CHOICES] = {0};
+	for (size_t i = 0; i < n; i++) {
+		h[i]         = argHashBytes(arg->choices[i], strlen(arg->choices[i]));
+		bucket_of[i] = (uint8_t)(argHashMix(h[i], 0) & hash->bucket_mask);
+		bucket_size[bucket_of[i]]++;
+	}
+
+	for (size_t size = n; size > 0; size--) {
+		for (size_t b = 0; b < buckets; b++) {
+			if (bucket_size[b] != size) continue;
+
+			uint32_t d = 1;
+			for (; d <= ENUM_MAX_DISPLACEMENT; d++) {
+				uint8_t taken[2 * ARG_ENUM_MAX_CHOICES] = {0};
+				bool    fits = true;
+				for (size_t i = 0; i < n && fits; i++) {
+					if (bucket_of[i] != b) continue;
+					uint32_t s = argHashMix(h[i], d) & hash->slot_mask;
+					fits = hash->slots[s] == 0 && !taken[s];
+					taken[s] = 1;
+				}
+				if (fits) break;
+			}
+			if (d > ENUM_MAX_DISPLACEMENT) {
+				argLogError("Could not build the choice table of argument %s", arg->flag);
+				return 1;
+			}
+
+			hash->displacement[b] = (uint8_t)d;
+			for (size_t i = 0; i < n; i++) {
+				if (bucket_of[i] == b) hash->slots[argHashMix(h[i], d) & hash->slot_mask] = (uint8_t)(i + 1);
+			}
+		}
+	}
+	return 0;
+}
+
+
+bool argEnumFind(const ArgEnumHash* hash, const char* str, size_t size, int32_t* out)
+{
+	uint32_t h = argHashBytes(str, size);
+	uint8_t  d = hash->displacement[argHashMix(h, 0) & hash->bucket_mask];
+	if (d == 0) return false;
+
+	uint8_t slot = hash->slots[argHashMix(h, d) & hash->slot_mask];
+	if (slot == 0) return false;
+
+	const char* name = hash->choices[slot - 1];
+	size_t n = 0;
+	while (n < size && name[n] != '\0' && name[n] == str[n]) n++;
+	if (n != size || name[n] != '\0') return false;
+	*out = slot - 1;
+	return true;
+}
@@ -0,0 +1,348 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// Positions index the tokens as if there was no gap. HEAD stands for the
+// data tokens in front of the first flag, which belong to no flag group.
+#define HEAD ARG_NO_TOKEN
+
+static ArgStateToken* stateAt(const ArgParseState* state, size_t i)
+{
+	if (i < state->gap_start) return &state->items[i];
+	return &state->items[i + (state->gap_end - state->gap_start)];
+}
+
+
+static void stateMoveGap(ArgParseState* state, size_t position)
+{
+	size_t gap = state->gap_end - state->gap_start;
+	if (position < state->gap_start) {
+		size_t n = state->gap_start - position;
+		memmove(&state->items[position + gap], &state->items[position], n * sizeof(ArgStateToken));
+	} else if (position > state->gap_start) {
+		size_t n = position - state->gap_start;
+		memmove(&state->items[state->gap_start], &state->items[state->gap_end], n * sizeof(ArgStateToken));
+	}
+	state->gap_start = position;
+	state->gap_end   = position + gap;
+}
+
+
+static void stateReserveGap(ArgParseState* state, size_t needed)
+{
+	size_t gap = state->gap_end - state->gap_start;
+	if (gap >= needed) return;
+
+	size_t tail     = state->capacity - state->gap_end;
+	size_t capacity = state->capacity == 0 ? 64 : state->capacity * 2;
+	while (capacity - (state->capacity - gap) < needed) capacity *= 2;
+
+	state->items = ARG_REALLOC(state->items, capacity * sizeof(ArgStateToken));
+	ARG_ASSERT(state->items != NULL && "Buy more RAM lol");
+	memmove(&state->items[capacity - tail], &state->items[state->gap_end], tail * sizeof(ArgStateToken));
+	state->gap_end  = capacity - tail;
+	state->capacity = capacity;
+}
+
+
+// Flag token owning token i, HEAD if token i is in front of every flag.
+static size_t stateGroupStart(const ArgParseState* state, size_t i)
+{
+	while (stateAt(state, i)->token.type != ARG_TOKEN_FLAG) {
+		if (i == 0) return HEAD;
+		i--;
+	}
+	return i;
+}
+
+
+// First of the tokens [begin, end) that is not a valid value of
+// args[declared], end when they all are.
+static size_t stateInvalidValue(const ArgParseState* state, size_t declared, size_t begin, size_t end)
+{
+	const Arg* arg = &state->args[declared];
+	if (!argIsNumeric(arg->type)) return end;
+
+	// A lone @bin: value is checked when the file is mapped
+	if (arg->binary && end == begin + 1 && argIsBinValue(stateAt(state, begin)->token.data)) return end;
+
+	ArgSequence sequence;
+	if (arg->range && end == begin + 1 && argParseSequence(arg->type, stateAt(state, begin)->token.data, &sequence)) return end;
+
+	for (size_t i = begin; i < end; i++) {
+		max_align_t scratch;
+		if (!argConvertValue(arg->type, argSchemaChoices(&state->schema, declared), stateAt(state, i)->token.data, &scratch)) {
+			return i;
+		}
+	}
+	return end;
+}
+
+
+static void stateValidateGroup(ArgParseState* state, size_t flag)
+{
+	ArgStateToken* t = stateAt(state, flag);
+	size_t count = argParseStateCount(state);
+	size_t end   = flag + 1;
+	while (end < count && stateAt(state, end)->token.type == ARG_TOKEN_DATA) end++;
+	size_t nargs = end - flag - 1;
+
+	t->declared     = argSchemaFind(&state->schema, t->token.data);
+	t->error        = ARG_ERROR_NONE;
+	t->error_offset = 0;
+	if (t->declared == ARG_NO_TOKEN) {
+		t->error = ARG_ERROR_UNDECLARED;
+		return;
+	}
+
+	const Arg* arg = &state->args[t->declared];
+	if ((arg->type == ARG_BOOL && nargs > 0) || (arg->type != ARG_BOOL && nargs == 0)) {
+		t->error = ARG_ERROR_TYPE_MISMATCH;
+		return;
+	}
+	if (arg->type != ARG_BOOL && arg->nargs > 0 && arg->nargs != nargs) {
+		t->error = ARG_ERROR_NARGS;
+		return;
+	}
+	size_t invalid = stateInvalidValue(state, t->declared, flag + 1, end);
+	if (invalid < end) {
+		t->error        = ARG_ERROR_VALUE;
+		t->error_offset = invalid - flag;
+	}
+}
+
+
+// Count rules of argPositionalLayout in argParse.
+static bool stateStrayInvalid(const ArgParseState* state)
+{
+	const Arg* variadic = state->positional_variadic;
+	if (state->stray < state->positional_fixed) return true;
+	if (variadic == NULL) return state->stray > state->positional_fixed;
+	return variadic->required && state->stray == state->positional_fixed;
+}
+
+
+// Splits the HEAD tokens over the positionals like assignPositionalArguments
+// and converts each value with the type of its positional. stray_value is
+// the first invalid one, ARG_NO_TOKEN when there is none or the count is
+// already wrong.
+static void stateValidateStray(ArgParseState* state)
+{
+	state->stray_value = ARG_NO_TOKEN;
+	if (stateStrayInvalid(state)) return;
+
+	const Arg* variadic;
+	size_t fixed = argPositionalLayout(state->args, state->args_size, state->stray, &variadic);
+	size_t at    = 0;
+	for (size_t i = 0; i < state->args_size; i++) {
+		const Arg* arg = &state->args[i];
+		if (!argIsPositional(arg)) continue;
+		size_t n = (arg == variadic) ? state->stray - fixed : arg->nargs;
+		size_t invalid = stateInvalidValue(state, i, at, at + n);
+		if (invalid < at + n) {
+			state->stray_value      = invalid;
+			state->stray_owner = i;
+			return;
+		}
+		at += n;
+	}
+}
+
+
+// Adds (sign = +1) or removes (sign = -1) a validated group from the error
+// counters.
+static void stateCountGroup(ArgParseState* state, size_t flag, int sign)
+{
+	const ArgStateToken* t = stateAt(state, flag);
+	if (t->error != ARG_ERROR_NONE) state->group_errors += sign;
+	if (t->declared == ARG_NO_TOKEN) return;
+
+	const Arg* arg = &state->args[t->declared];
+	size_t before = state->occurrences[t->declared];
+	size_t after  = before + sign;
+	state->occurrences[t->declared] = after;
+
+	if (!arg->append && before <= 1 && after > 1) state->duplicates++;
+	if (!arg->append && before > 1 && after <= 1) state->duplicates--;
+	if (arg->required && arg->type != ARG_BOOL) {
+		if (before == 0 && after == 1) state->missing--;
+		if (before == 1 && after == 0) state->missing++;
+	}
+}
+
+
+const char* argErrorKindToString(ArgErrorKind kind)
+{
+	if (kind == ARG_ERROR_NONE)          return "ARG_ERROR_NONE";
+	if (kind == ARG_ERROR_UNDECLARED)    return "ARG_ERROR_UNDECLARED";
+	if (kind == ARG_ERROR_DUPLICATE)     return "ARG_ERROR_DUPLICATE";
+	if (kind == ARG_ERROR_MISSING)       return "ARG_ERROR_MISSING";
+	if (kind == ARG_ERROR_TYPE_MISMATCH) return "ARG_ERROR_TYPE_MISMATCH";
+	if (kind == ARG_ERROR_NARGS)         return "ARG_ERROR_NARGS";
+	if (kind == ARG_ERROR_VALUE)         return "ARG_ERROR_VALUE";
+	if (kind == ARG_ERROR_STRAY_DATA)    return "ARG_ERROR_STRAY_DATA";
+	argLogError("Unknown error kind %d", kind);
+	exit(1);
+}
+
+
+bool argParseStateInit(ArgParseState* state, const Arg* args, size_t args_size)
+{
+	memset(state, 0, sizeof(*state));
+	state->args        = args;
+	state->args_size   = args_size;
+	state->stray_value = ARG_NO_TOKEN;
+	if (argSchemaCompile(&state->schema, args, args_size)) return 1;
+	state->occurrences = calloc(args_size + 1, sizeof(size_t));
+	if (state->occurrences == NULL) {
+		argLogError("Could not allocate the parse state of %zu arguments", args_size);
+		argSchemaFree(&state->schema);
+		return 1;
+	}
+	for (size_t i = 0; i < args_size; i++) {
+		if (argIsPositional(&args[i])) {
+			if (args[i].nargs > 0) {
+				state->positional_fixed += args[i].nargs;
+			} else {
+				state->positional_variadic = &args[i];
+			}
+		} else if (args[i].required && args[i].type != ARG_BOOL) {
+			state->missing++;
+		}
+	}
+	return 0;
+}
+
+
+void argParseStateFree(ArgParseState* state)
+{
+	argSchemaFree(&state->schema);
+	free(state->items);
+	free(state->occurrences);
+	memset(state, 0, sizeof(*state));
+}
+
+
+bool argParseStateEdit(ArgParseState* state, size_t position, size_t remove_count,
+                       const char** insert, size_t insert_count)
+{
+	size_t count = argParseStateCount(state);
+	if (position > count || remove_count > count - position) {
+		argLogError("Edit of %zu tokens at %zu is out of the %zu tokens", remove_count, position, count);
+		return 1;
+	}
+
+	// Affected range: from the group in front of the edit up to the next
+	// flag after it. Groups outside of it keep their validation.
+	size_t group = (position == 0) ? HEAD : stateGroupStart(state, position - 1);
+	size_t lo = (group == HEAD) ? 0 : group;
+	size_t hi = position + remove_count;
+	while (hi < count && stateAt(state, hi)->token.type == ARG_TOKEN_DATA) hi++;
+
+	for (size_t i = lo; i < hi; i++) {
+		if (stateAt(state, i)->token.type == ARG_TOKEN_FLAG) stateCountGroup(state, i, -1);
+	}
+
+	stateMoveGap(state, position);
+	state->gap_end += remove_count;
+	stateReserveGap(state, insert_count);
+	for (size_t i = 0; i < insert_count; i++) {
+		ArgStateToken* t = &state->items[state->gap_start++];
+		memset(t, 0, sizeof(*t));
+		t->token.type = argClassifyToken(insert[i]);
+		t->token.data = insert[i];
+	}
+
+	hi = hi - remove_count + insert_count;
+	for (size_t i = lo; i < hi; i++) {
+		if (stateAt(state, i)->token.type == ARG_TOKEN_FLAG) {
+			stateValidateGroup(state, i);
+			stateCountGroup(state, i, +1);
+		}
+	}
+
+	if (group == HEAD) {
+		state->stray = 0;
+		while (state->stray < hi && stateAt(state, state->stray)->token.type == ARG_TOKEN_DATA) {
+			state->stray++;
+		}
+		stateValidateStray(state);
+	}
+	return 0;
+}
+
+
+size_t argParseStateCount(const ArgParseState* state)
+{
+	return state->capacity - (state->gap_end - state->gap_start);
+}
+
+
+const char* argParseStateToken(const ArgParseState* state, size_t i)
+{
+	return stateAt(state, i)->token.data;
+}
+
+
+size_t argParseStateErrorCount(const ArgParseState* state)
+{
+	return state->group_errors + state->duplicates + state->missing + stateStrayInvalid(state) +
+	       (state->stray_value != ARG_NO_TOKEN);
+}
+
+
+void argParseStateErrors(const ArgParseState* state, ArgErrors* errors)
+{
+	if (stateStrayInvalid(state)) {
+		ArgError e = { .kind = ARG_ERROR_STRAY_DATA, .flag = NULL, .token = 0 };
+		ARG_DA_APPEND(errors, e);
+	}
+	if (state->stray_value != ARG_NO_TOKEN) {
+		ArgError e = { .kind = ARG_ERROR_VALUE, .flag = state->args[state->stray_owner].flag, .token = state->stray_value };
+		ARG_DA_APPEND(errors, e);
+	}
+
+	size_t count = argParseStateCount(state);
+	for (size_t i = 0; i < count; i++) {
+		const ArgStateToken* t = stateAt(state, i);
+		if (t->token.type != ARG_TOKEN_FLAG || t->error == ARG_ERROR_NONE) continue;
+		ArgError e = { .kind = t->error, .flag = t->token.data, .token = i + t->error_offset };
+		ARG_DA_APPEND(errors, e);
+	}
+
+	for (size_t i = 0; i < state->args_size; i++) {
+		const Arg* arg = &state->args[i];
+		if (state->occurrences[i] > 1 && !arg->append) {
+			ArgError e = { .kind = ARG_ERROR_DUPLICATE, .flag = arg->flag, .token = ARG_NO_TOKEN };
+			ARG_DA_APPEND(errors, e);
+		}
+		if (state->occurrences[i] == 0 && arg->required && arg->type != ARG_BOOL && !argIsPositional(arg)) {
+			ArgError e = { .kind = ARG_ERROR_MISSING, .flag = arg->flag, .token = ARG_NO_TOKEN };
+			ARG_DA_APPEND(errors, e);
+		}
+	}
+}
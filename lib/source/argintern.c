@@ -0,0 +1,85 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// Open addressing table of ids + 1 with linear probing, at most half
+// full. It only lives for the call, the ids and the distinct strings are
+// the result.
+
+void argInternStrings(Arg* arg, char** values, size_t count, ArgArena* arena)
+{
+	size_t slots = 2;
+	while (slots < 2 * count) slots *= 2;
+	size_t mask = slots - 1;
+
+	uint32_t*    ids;
+	const char** strings;
+	uint32_t*    table;
+	if (arena != NULL) {
+		// One block: ids, strings then the table
+		size_t ids_size = (count * sizeof(uint32_t) + sizeof(char*) - 1) / sizeof(char*) * sizeof(char*);
+		char*  block    = argArenaAlloc(arena, ids_size + count * sizeof(char*) + slots * sizeof(uint32_t));
+		ARG_ASSERT(block != NULL);
+		ids     = (uint32_t*)block;
+		strings = (const char**)(block + ids_size);
+		table   = (uint32_t*)(block + ids_size + count * sizeof(char*));
+		memset(table, 0, slots * sizeof(uint32_t));
+	} else {
+		ids     = ARG_REALLOC(NULL, (count + 1) * sizeof(uint32_t));
+		strings = ARG_REALLOC(NULL, (count + 1) * sizeof(char*));
+		table   = calloc(slots, sizeof(uint32_t));
+		ARG_ASSERT(ids != NULL && strings != NULL && table != NULL && "Buy more RAM lol");
+	}
+
+	size_t distinct = 0;
+	for (size_t i = 0; i < count; i++) {
+		size_t size = strlen(values[i]);
+		size_t s    = argHashMix(argHashBytes(values[i], size), 0) & mask;
+		while (table[s] != 0 && strcmp(strings[table[s] - 1], values[i]) != 0) {
+			s = (s + 1) & mask;
+		}
+		if (table[s] == 0) {
+			strings[distinct++] = values[i];
+			table[s] = (uint32_t)distinct;
+		}
+		ids[i] = table[s] - 1;
+	}
+
+	if (arena == NULL) {
+		free(table);
+		const char** shrunk = ARG_REALLOC(strings, (distinct + 1) * sizeof(char*));
+		if (shrunk != NULL) strings = shrunk;
+	}
+	arg->data.interned = (ArgInterned){
+		.items         = ids,
+		.count         = count,
+		.capacity      = arena ? 0 : count,
+		.strings       = strings,
+		.strings_count = distinct,
+	};
+}
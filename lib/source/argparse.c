@@ -19,10 +19,30 @@
 // OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
 // WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
-#define NOB_IMPLEMENTATION
-#define NOB_STRIP_PREFIX
-#include "nob.h"
+#include <stdarg.h>
+#include "argcore.h"
 #include "argparse.h"
+#include "argparse_internal.h"
+
+void argLogError(const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+#ifdef ARG_PROBES_ENABLED
+	// Every error exit of the library is logged through here
+	char message[256];
+	va_list copy;
+	va_copy(copy, args);
+	vsnprintf(message, sizeof(message), fmt, copy);
+	va_end(copy);
+	ARG_PROBE1(error, message);
+#endif
+	fprintf(stderr, "[ERROR] ");
+	vfprintf(stderr, fmt, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
+
 
 const char* argTypeToString(ArgType a)
 {
@@ -30,7 +50,16 @@ const char* argTypeToString(ArgType a)
 	if (a == ARG_STRING) return "ARG_STRING";
 	if (a == ARG_LONG)   return "ARG_LONG";
 	if (a == ARG_DOUBLE) return "ARG_DOUBLE";
-	nob_log(ERROR, "Unknown argument type %s", a);
+	if (a == ARG_INT8)   return "ARG_INT8";
+	if (a == ARG_INT16)  return "ARG_INT16";
+	if (a == ARG_INT32)  return "ARG_INT32";
+	if (a == ARG_UINT8)  return "ARG_UINT8";
+	if (a == ARG_UINT16) return "ARG_UINT16";
+	if (a == ARG_UINT32) return "ARG_UINT32";
+	if (a == ARG_UINT64) return "ARG_UINT64";
+	if (a == ARG_FLOAT)  return "ARG_FLOAT";
+	if (a == ARG_ENUM)   return "ARG_ENUM";
+	argLogError("Unknown argument type %s", a);
 	exit(1);
 }
 
@@ -39,39 +68,52 @@ const char* argTokenTypeToString(ArgType a)
 {
 	if (a == ARG_TOKEN_FLAG) return "ARG_TOKEN_FLAG";
 	if (a == ARG_TOKEN_DATA) return "ARG_TOKEN_DATA";
-	nob_log(ERROR, "Unknown argument type %s", a);
+	argLogError("Unknown argument type %s", a);
 	exit(1);
 }
 
 
+ArgTokenType argClassifyToken(const char* str)
+{
+	if (str[0] == '-' && str[1] == '-') return ARG_TOKEN_FLAG;
+	return ARG_TOKEN_DATA;
+}
+
+
+bool argIsPositional(const Arg* arg)
+{
+	return argClassifyToken(arg->flag) == ARG_TOKEN_DATA;
+}
+
+
 bool tokenizeArguments(int argc, char** argv, ArgTokens* tokens)
 {
+	ARG_PROBE1(tokenize_start, argc);
 	ArgToken t;
 	for (size_t i = 1; i < argc; i++) {
-		if (argv[i][0] == '-' && argv[i][1] == '-') {
-			t.type = ARG_TOKEN_FLAG;
-			t.data = argv[i];
-		} else {
-			t.type = ARG_TOKEN_DATA;
-			t.data = argv[i];
-		}
-		da_append(tokens, t);
+		t.type = argClassifyToken(argv[i]);
+		t.data = argv[i];
+		ARG_DA_APPEND(tokens, t);
 	}
+	ARG_PROBE1(tokenize_done, tokens->count);
 	return 0;
 }
 
 
-bool parseFlagNargs(const ArgTokens* tokens, size_t* current_count, Args* args_parsed)
+// Like parseFlagNargs but when values is given the data of the flag is
+// appended to it and the flag gets a span of it (capacity 0) instead of
+// an allocation of its own. values must be reserved for every data token.
+bool parseFlagNargsInto(const ArgTokens* tokens, size_t* current_count, Args* args_parsed, ArrayOfStrings* values)
 {
 	size_t i = *current_count;
 	if(i >= tokens->count)
 	{
-		nob_log(ERROR, "Current count %d is bigger that the tokens->count %d: ", i, tokens->count);
+		argLogError("Current count %d is bigger that the tokens->count %d: ", i, tokens->count);
 		exit(1);
 	}
 
 	if (tokens->items[i].type != ARG_TOKEN_FLAG) {
-		nob_log(ERROR, "Token %s type is not ARG_TOKEN_FLAG it is of type: %s", tokens->items[i].data,
+		argLogError("Token %s type is not ARG_TOKEN_FLAG it is of type: %s", tokens->items[i].data,
 			argTokenTypeToString(tokens->items[i].type));
 		exit(1);
 	}
@@ -88,31 +130,47 @@ bool parseFlagNargs(const ArgTokens* tokens, size_t* current_count, Args* args_p
 	Arg arg = {0};	
 	arg.type = ARG_STRING;
 	arg.flag = tokens->items[i++].data;
-	ArrayOfStrings a = {0};
-	da_append(&arg.data.array_string, (char*)tokens->items[i++].data);
 
-	while (tokens->items[i].type == ARG_TOKEN_DATA && i < tokens->count) {
-		da_append(&arg.data.array_string, (char*)tokens->items[i].data);
+	// Sized exactly instead of growing from ARG_DA_INIT_CAP per flag
+	size_t n = 0;
+	while (i + n < tokens->count && tokens->items[i + n].type == ARG_TOKEN_DATA) n++;
+	if (values != NULL) {
+		ARG_ASSERT(values->count + n <= values->capacity);
+		arg.data.array_string.items = values->items + values->count;
+		values->count += n;
+	} else {
+		arg.data.array_string.items    = ARG_REALLOC(NULL, (n + 1) * sizeof(char*));
+		arg.data.array_string.capacity = n + 1;
+		ARG_ASSERT(arg.data.array_string.items != NULL && "Buy more RAM lol");
+	}
+	while (i < tokens->count && tokens->items[i].type == ARG_TOKEN_DATA) {
+		arg.data.array_string.items[arg.data.array_string.count++] = (char*)tokens->items[i].data;
 		i++;
 	}
 	
-	da_append(args_parsed, arg);
+	ARG_DA_APPEND(args_parsed, arg);
 	*current_count = i;
 	return 0;
 }
 
 
+bool parseFlagNargs(const ArgTokens* tokens, size_t* current_count, Args* args_parsed)
+{
+	return parseFlagNargsInto(tokens, current_count, args_parsed, NULL);
+}
+
+
 bool parseFlagBool(const ArgTokens* tokens, size_t* current_count, Args* args_parsed)
 {
 	size_t i = *current_count;
 	if(i >= tokens->count)
 	{
-		nob_log(ERROR, "Current count %d is bigger that the tokens->count %d: ", i, tokens->count);
+		argLogError("Current count %d is bigger that the tokens->count %d: ", i, tokens->count);
 		exit(1);
 	}
 
 	if (tokens->items[i].type != ARG_TOKEN_FLAG) {
-		nob_log(ERROR, "Token %s type is not ARG_TOKEN_FLAG it is of type: ", tokens->items[i].data, tokens->items[i].type);
+		argLogError("Token %s type is not ARG_TOKEN_FLAG it is of type: ", tokens->items[i].data, tokens->items[i].type);
 		exit(1);
 	}
 
@@ -121,60 +179,92 @@ bool parseFlagBool(const ArgTokens* tokens, size_t* current_count, Args* args_pa
 	arg.type = ARG_BOOL;
 	arg.flag = tokens->items[i++].data;
 	arg.data.exists = true;
-	da_append(args_parsed, arg);
+	ARG_DA_APPEND(args_parsed, arg);
 	*current_count = i;
 	return 0;
 }
 
 
-bool parseArguments(const ArgTokens* tokens, Args* args_parsed)
+bool parseArguments(const ArgTokens* tokens, Args* args_parsed, ArrayOfStrings* values)
 {
+	ARG_PROBE1(parse_start, tokens->count);
+
+	// Data tokens in front of the first flag are the positional arguments
 	size_t current_count = 0;
+	while (current_count < tokens->count && tokens->items[current_count].type == ARG_TOKEN_DATA) {
+		current_count++;
+	}
+
 	while (current_count < tokens->count) {
-		if (!parseFlagNargs(tokens, &current_count, args_parsed)) continue;
+		if (!parseFlagNargsInto(tokens, &current_count, args_parsed, values)) continue;
 		if (!parseFlagBool(tokens, &current_count, args_parsed))  continue;
 	}
-
+	ARG_PROBE1(parse_done, args_parsed->count);
+	return 0;
 }
 
 
-bool checkParsedArguments(const Args* args_parsed, Arg* args, size_t args_size)
+// Maps every parsed flag to its declaration through the sorted schema:
+// parsed_index[declared] is the first occurrence in args_parsed or
+// ARG_NO_TOKEN, and next[k] is the occurrence after k of the same .append
+// argument or ARG_NO_TOKEN. While matching, parsed_index points at the
+// last occurrence of a circular list, so each append is O(1).
+void matchParsedArguments(const Args* args_parsed, const ArgSchema* schema, size_t* parsed_index, size_t* next)
 {
-	da_foreach(Arg, a, args_parsed) {
-		// Duplicate flags check
-		da_foreach(Arg, b, args_parsed) {
-			if (a != b && !strcmp(b->flag,a->flag)) {
-				nob_log(ERROR, "Duplicate flags %s provided", a->flag);
-				exit(1);
-			}
-		}
+	ARG_PROBE2(check_start, args_parsed->count, schema->args_size);
+	for (size_t i = 0; i < schema->args_size; i++) {
+		parsed_index[i] = ARG_NO_TOKEN;
+	}
 
+	ARG_DA_FOREACH(Arg, a, args_parsed) {
 		// Extra undeclared flags check
-		bool found = false;
-		for (size_t i = 0; i < args_size; i++) {
-			if (!strcmp(a->flag,args[i].flag)) {
-				found = true;
-				break;
-			}
-		}
-		if (!found) {
-			nob_log(ERROR, "Undeclared argument flag %s provided of type %s please declared it as an input argument", 
+		size_t declared = argSchemaFind(schema, a->flag);
+		if (declared == ARG_NO_TOKEN) {
+			argLogError("Undeclared argument flag %s provided of type %s please declared it as an input argument", 
 					a->flag,
 					argTypeToString(a->type)
 					);
 			exit(1);
 		}
-	}
 
-	for (size_t i = 0; i < args_size; i++) {
-		for (size_t j = 0; j < args_size; j++) {
-			if (i == j) continue;
-			if (!strcmp(args[i].flag, args[j].flag)) {
-				nob_log(ERROR, "Duplicate flags %s declared. Please declare each flags only 1 time.", args[i].flag); 
-				exit(1);
-			}
+		size_t k    = a - args_parsed->items;
+		size_t last = parsed_index[declared];
+		if (last == ARG_NO_TOKEN) {
+			next[k] = k;
+		} else if (schema->args[declared].append) {
+			next[k]    = next[last];
+			next[last] = k;
+		} else {
+			// Duplicate flags check
+			argLogError("Duplicate flags %s provided", a->flag);
+			exit(1);
 		}
+		parsed_index[declared] = k;
 	}
+
+	for (size_t i = 0; i < schema->args_size; i++) {
+		size_t last = parsed_index[i];
+		if (last == ARG_NO_TOKEN) continue;
+		parsed_index[i] = next[last];
+		next[last]      = ARG_NO_TOKEN;
+	}
+	ARG_PROBE2(check_done, args_parsed->count, schema->args_size);
+}
+
+
+bool checkParsedArguments(const Args* args_parsed, Arg* args, size_t args_size)
+{
+	ArgSchema schema;
+	if (argSchemaCompile(&schema, args, args_size)) exit(1);
+
+	size_t* parsed_index = malloc((args_size + 1) * sizeof(size_t));
+	size_t* next         = malloc((args_parsed->count + 1) * sizeof(size_t));
+	matchParsedArguments(args_parsed, &schema, parsed_index, next);
+
+	free(next);
+	free(parsed_index);
+	argSchemaFree(&schema);
+	return 0;
 }
 
 void displayHelp(Arg* args, size_t args_size)
@@ -202,35 +292,331 @@ void displayHelp(Arg* args, size_t args_size)
 	}
 }
 
-bool argParse(int argc, char** argv, Arg* args, size_t args_size)
+// Sizes the numeric array of arg for count values, from the arena when
+// one is given.
+static void* reserveNumbers(Arg* arg, size_t count, ArgArena* arena)
+{
+	size_t capacity;
+	void*  items = argNumbers(arg, NULL, &capacity);
+	if (capacity == 0) items = NULL; // a span or a mapping, never reallocated
+	if (arena != NULL) {
+		items    = argArenaAlloc(arena, count * argTypeSize(arg->type));
+		capacity = count;
+		ARG_ASSERT(items != NULL);
+	} else if (capacity < count) {
+		items    = ARG_REALLOC(items, count * argTypeSize(arg->type));
+		capacity = count;
+		ARG_ASSERT(items != NULL && "Buy more RAM lol");
+	}
+	argSetNumbers(arg, items, 0, capacity);
+	return items;
+}
+
+
+static void valueMismatch(const Arg* arg, const char* parsed_flag, const char* value)
+{
+	bool ranged = arg->range && (arg->type == ARG_LONG || arg->type == ARG_DOUBLE);
+	if ((arg->binary && argIsBinValue(value)) || (ranged && argIsSequenceValue(value))) {
+		argLogError("%s given to %s must be the only value of the argument", value, parsed_flag);
+		exit(1);
+	}
+	argLogError("Declared argument with flag %s and type %s does not match the parsed one with flag %s and argument %s",
+			arg->flag,
+			argTypeToString(arg->type),
+			parsed_flag,
+			value
+		);
+	exit(1);
+}
+
+
+// A lone "first..last[:step]" value is kept as a generator.
+static void assignSequence(Arg* arg, const char* parsed_flag, const char* value)
 {
+	ArgSequence sequence;
+	if (!argParseSequence(arg->type, value, &sequence)) {
+		argLogError("%s given to %s is not a valid non empty range of %s", value, parsed_flag, argTypeToString(arg->type));
+		exit(1);
+	}
+	if (arg->nargs > 0 && sequence.count != arg->nargs) {
+		argLogError("Declared argument with flag %s and nargs %zu does not match the %zu values of %s",
+				arg->flag, arg->nargs, sequence.count, value);
+		exit(1);
+	}
+	arg->data.sequence = sequence;
+}
+
+
+void assignArgumentData(Arg* arg, const ArgEnumHash* choices, const char* parsed_flag, ArrayOfStrings values, ArgArena* arena)
+{
+	if (arg->type == ARG_STRING && arg->intern) {
+		argInternStrings(arg, values.items, values.count, arena);
+	} else if (arg->type == ARG_STRING) {
+		arg->data.array_string = values;
+	} else if (arg->range && (arg->type == ARG_LONG || arg->type == ARG_DOUBLE) && values.count == 1 && argIsSequenceValue(values.items[0])) {
+		assignSequence(arg, parsed_flag, values.items[0]);
+	} else if (arg->binary && argIsNumeric(arg->type) && values.count == 1 && argIsBinValue(values.items[0])) {
+		if (argMapBinary(arg, parsed_flag, values.items[0])) exit(1);
+	} else if (argIsNumeric(arg->type)) {
+		ARG_PROBE3(convert_start, arg->flag, arg->type, values.count);
+		void* dst = reserveNumbers(arg, values.count, arena);
+		size_t failed = argConvertNumbers(arg->type, choices, values.items, values.count, dst, arena == NULL);
+		if (failed < values.count) valueMismatch(arg, parsed_flag, values.items[failed]);
+		ARG_PROBE3(convert_done, arg->flag, arg->type, values.count);
+		size_t capacity;
+		argNumbers(arg, NULL, &capacity);
+		argSetNumbers(arg, dst, values.count, capacity);
+	}
+}
+
+
+size_t argPositionalLayout(const Arg* args, size_t args_size, size_t count, const Arg** variadic)
+{
+	size_t fixed = 0;
+	*variadic = NULL;
+	for (size_t i = 0; i < args_size; i++) {
+		if (!argIsPositional(&args[i])) continue;
+		if (args[i].type == ARG_BOOL) {
+			argLogError("Positional argument %s cannot be of type ARG_BOOL", args[i].flag);
+			exit(1);
+		}
+		if (args[i].nargs > 0) {
+			fixed += args[i].nargs;
+		} else if (*variadic != NULL) {
+			argLogError("Positional arguments %s and %s both have nargs = inf. Please declare only 1 of them.", (*variadic)->flag, args[i].flag);
+			exit(1);
+		} else {
+			*variadic = &args[i];
+		}
+	}
+
+	if (count < fixed || (*variadic == NULL && count > fixed)) {
+		argLogError("Expected %zu positional arguments but %zu were provided", fixed, count);
+		exit(1);
+	}
+	if (*variadic != NULL && (*variadic)->required && count == fixed) {
+		argLogError("Input argument %s is required and it is not provided", (*variadic)->flag);
+		exit(1);
+	}
+	return fixed;
+}
+
+
+// ARG_STRING values of a heap parse that point into its temporary pool
+// get an array of their own, owned by the caller.
+static ArrayOfStrings ownStrings(const Arg* arg, ArrayOfStrings values, ArgArena* arena)
+{
+	if (arena != NULL || arg->type != ARG_STRING || arg->intern) return values;
+	char** items = ARG_REALLOC(NULL, (values.count + 1) * sizeof(char*));
+	ARG_ASSERT(items != NULL && "Buy more RAM lol");
+	memcpy(items, values.items, values.count * sizeof(char*));
+	return (ArrayOfStrings){ .items = items, .count = values.count, .capacity = values.count };
+}
+
+
+// Splits the leading data tokens over the declared positional arguments
+// in declaration order. ARG_STRING values are spans of argv (capacity 0),
+// the strings are neither copied nor reallocated. With own the values do
+// not outlive the parse and are copied like flag values.
+void assignPositionalArguments(char** values, size_t count, Arg* args, const ArgSchema* schema, bool own, ArgArena* arena)
+{
+	const Arg* variadic;
+	size_t fixed = argPositionalLayout(args, schema->args_size, count, &variadic);
+
+	size_t at = 0;
+	for (size_t i = 0; i < schema->args_size; i++) {
+		if (!argIsPositional(&args[i])) continue;
+		size_t n = (&args[i] == variadic) ? count - fixed : args[i].nargs;
+		ArrayOfStrings span = { .items = values + at, .count = n, .capacity = 0 };
+		if (own) span = ownStrings(&args[i], span, arena);
+		assignArgumentData(&args[i], argSchemaChoices(schema, i), args[i].flag, span, arena);
+		at += n;
+	}
+}
+
+
+void* argArenaAlloc(ArgArena* arena, size_t size)
+{
+	size_t alignment = _Alignof(max_align_t);
+	size_t misalign  = (uintptr_t)(arena->base + arena->used) % alignment;
+	size_t at        = arena->used + (misalign ? alignment - misalign : 0);
+	if (at > arena->size || size > arena->size - at) return NULL;
+	arena->used = at + size;
+	return arena->base + at;
+}
+
+
+// Every buffer of a parse is sized up front, from the arena when one is
+// given and from the heap otherwise, so the da_append calls below never
+// grow anything.
+static void* parseAlloc(ArgArena* arena, size_t size)
+{
+	void* p = (arena != NULL) ? argArenaAlloc(arena, size) : malloc(size);
+	ARG_ASSERT(p != NULL && "Buy more RAM lol");
+	return p;
+}
+
+
+// Values of every occurrence of an .append argument, total in all. The
+// result is allocated once at its exact size and filled occurrence by
+// occurrence in command line order, nothing is copied on growth.
+static void assignAccumulated(Arg* arg, const ArgEnumHash* choices, const Args* args_parsed, size_t first, const size_t* next, size_t total, ArgArena* arena)
+{
+	if (arg->type == ARG_STRING) {
+		char** items = parseAlloc(arena, total * sizeof(char*));
+		size_t at    = 0;
+		for (size_t k = first; k != ARG_NO_TOKEN; k = next[k]) {
+			ArrayOfStrings v = args_parsed->items[k].data.array_string;
+			memcpy(items + at, v.items, v.count * sizeof(char*));
+			at += v.count;
+		}
+		if (arg->intern) {
+			argInternStrings(arg, items, total, arena);
+			if (arena == NULL) free(items);
+			return;
+		}
+		// Heap results are owned by the caller, arena ones are spans
+		arg->data.array_string = (ArrayOfStrings){ .items = items, .count = total, .capacity = arena ? 0 : total };
+	} else if (argIsNumeric(arg->type)) {
+		ARG_PROBE3(convert_start, arg->flag, arg->type, total);
+		char*  dst  = reserveNumbers(arg, total, arena);
+		size_t size = argTypeSize(arg->type);
+		size_t at   = 0;
+		for (size_t k = first; k != ARG_NO_TOKEN; k = next[k]) {
+			ArrayOfStrings v = args_parsed->items[k].data.array_string;
+			size_t failed = argConvertNumbers(arg->type, choices, v.items, v.count, dst + at * size, arena == NULL);
+			if (failed < v.count) valueMismatch(arg, args_parsed->items[k].flag, v.items[failed]);
+			at += v.count;
+		}
+		ARG_PROBE3(convert_done, arg->flag, arg->type, total);
+		size_t capacity;
+		argNumbers(arg, NULL, &capacity);
+		argSetNumbers(arg, dst, total, capacity);
+	}
+}
+
+
+// Permissive mode: takes the unknown flags, each with the data tokens
+// after it, out of tokens and records their argv index ranges.
+static void dropUnknownFlags(ArgTokens* tokens, const ArgSchema* schema, ArgLeftovers* leftovers)
+{
+	size_t w = 0;
+	for (size_t i = 0; i < tokens->count;) {
+		const ArgToken* t = &tokens->items[i];
+		if (t->type == ARG_TOKEN_FLAG && strcmp(t->data, "--help") && argSchemaFind(schema, t->data) == ARG_NO_TOKEN) {
+			size_t end = i + 1;
+			while (end < tokens->count && tokens->items[end].type == ARG_TOKEN_DATA) end++;
+			// Token i is argv[i + 1]
+			ArgRange unknown = { .begin = i + 1, .end = end + 1 };
+			ARG_DA_APPEND(&leftovers->unknown, unknown);
+			i = end;
+		} else {
+			tokens->items[w++] = tokens->items[i++];
+		}
+	}
+	tokens->count = w;
+}
+
+
+// compiled is the schema of args when the caller already has one, NULL
+// compiles it for this parse.
+static bool parseWithArena(int argc, char** argv, Arg* args, size_t args_size, const ArgSchema* compiled, ArgArena* arena, ArgLeftovers* leftovers)
+{
+	ARG_PROBE2(start, argc, args_size);
+	if (argc > 1 && !strcmp(argv[1], "__complete")) {
+		if (compiled != NULL) argCompleteSchema(compiled, argc - 1, argv + 1);
+		argCompleteCommand(args, args_size, argc - 1, argv + 1);
+	}
+
+	// The Arg[] may have been used with argParseSpans before
+	for (size_t i = 0; i < args_size; i++) args[i].spans = false;
+
+	// In permissive mode "--" ends the arguments of this parser
+	int end = argc;
+	if (leftovers != NULL) {
+		for (int i = 1; i < argc; i++) {
+			if (!strcmp(argv[i], "--")) {
+				end = i;
+				break;
+			}
+		}
+		leftovers->separator = end < argc;
+		leftovers->remainder = (ArgRange){ .begin = (end < argc) ? end + 1 : argc, .end = argc };
+	}
+
+	size_t n = (end > 1) ? (size_t)end - 1 : 0;
 	ArgTokens tokens = {0};
-	tokenizeArguments(argc, argv, &tokens);
+	tokens.items    = parseAlloc(arena, (n + 1) * sizeof(ArgToken));
+	tokens.capacity = n + 1;
+	tokenizeArguments(end, argv, &tokens);
+
+	ArgSchema schema;
+	if (compiled != NULL) {
+		schema = *compiled;
+	} else {
+		ArgSchemaEntry* sorted = parseAlloc(arena, (args_size + 1) * sizeof(ArgSchemaEntry));
+		ArgEnumHash*    enums  = argHasEnums(args, args_size) ? parseAlloc(arena, args_size * sizeof(ArgEnumHash)) : NULL;
+		if (argSchemaCompileInto(&schema, args, args_size, sorted, enums)) exit(1);
+	}
+	if (leftovers != NULL) {
+		dropUnknownFlags(&tokens, &schema, leftovers);
+		n = tokens.count;
+	}
+
+	size_t flags = 0;
+	ARG_DA_FOREACH(ArgToken, t, &tokens) {
+		if (t->type == ARG_TOKEN_FLAG) flags++;
+	}
 
 	Args args_parsed = {0};
-	parseArguments(&tokens, &args_parsed);
+	args_parsed.items    = parseAlloc(arena, (flags + 1) * sizeof(Arg));
+	args_parsed.capacity = flags + 1;
+	ArrayOfStrings values = {0};
+	values.items    = parseAlloc(arena, (n - flags + 1) * sizeof(char*));
+	values.capacity = n - flags + 1;
+	parseArguments(&tokens, &args_parsed, &values);
 
 
 	if (args_parsed.count == 1) {
 		if (!strcmp(args_parsed.items[0].flag, "--help")) {
 			displayHelp(args, args_size);
+			if (arena == NULL) {
+				free(tokens.items);
+				free(args_parsed.items);
+				free(values.items);
+				if (compiled == NULL) {
+					free(schema.sorted);
+					free(schema.enums);
+				}
+			}
 			return 0;
 		}
 	}
 
-	checkParsedArguments(&args_parsed, args, args_size);
+	size_t* parsed_index = parseAlloc(arena, (args_size + 1) * sizeof(size_t));
+	size_t* next         = parseAlloc(arena, (flags + 1) * sizeof(size_t));
+	matchParsedArguments(&args_parsed, &schema, parsed_index, next);
+
+	size_t positionals = 0;
+	while (positionals < tokens.count && tokens.items[positionals].type == ARG_TOKEN_DATA) {
+		positionals++;
+	}
+	// argv may be compacted after a permissive parse, so the positional
+	// spans go into the values pool instead of pointing at argv
+	char** positional_values = argv + 1;
+	if (leftovers != NULL) {
+		ARG_ASSERT(values.count + positionals <= values.capacity);
+		positional_values = values.items + values.count;
+		memcpy(positional_values, argv + 1, positionals * sizeof(char*));
+		values.count += positionals;
+	}
+	assignPositionalArguments(positional_values, positionals, args, &schema, leftovers != NULL, arena);
 
 	for (size_t i = 0; i < args_size; i++) {
+		if (argIsPositional(&args[i])) continue;
+
 		// Find parsed arg
-		Arg* arg_parsed;
-		bool found = false;
-		da_foreach(Arg, a, &args_parsed) {
-			if (!strcmp(args[i].flag, a->flag)) {
-				arg_parsed = a;
-				found = true;
-				break;
-			}
-		}
+		bool found = parsed_index[i] != ARG_NO_TOKEN;
 
 		// Required check 
 		// (Ignore the required in a bool flag)
@@ -238,78 +624,161 @@ bool argParse(int argc, char** argv, Arg* args, size_t args_size)
 			continue;
 		}
 		if (!found && args[i].required ) {
-			nob_log(ERROR, "Input argument %s is required and it is not provided", args[i].flag);
+			argLogError("Input argument %s is required and it is not provided", args[i].flag);
 			exit(1);
 		} else if (!found && !args[i].required) {
 			continue;
 		}
 
+		// Type and nargs checks hold for every occurrence
+		size_t total = 0;
+		for (size_t k = parsed_index[i]; k != ARG_NO_TOKEN; k = next[k]) {
+			Arg* arg_parsed = &args_parsed.items[k];
+
+			// Flag type check
+			if ((args[i].type == ARG_BOOL && arg_parsed->type != ARG_BOOL) ||
+			    (args[i].type != ARG_BOOL && arg_parsed->type == ARG_BOOL)) {
+				argLogError("Declared argument with flag %s and type %s does not match the parsed one with flag %s and %s",
+						args[i].flag,
+						argTypeToString(args[i].type),
+						arg_parsed->flag,
+						argTypeToString(arg_parsed->type));
+				exit(1);
+			}
 
-		// Flag type check
-		if ((args[i].type == ARG_BOOL && arg_parsed->type != ARG_BOOL) ||
-		    (args[i].type != ARG_BOOL && arg_parsed->type == ARG_BOOL)) {
-			nob_log(ERROR, "Declared argument with flag %s and type %s does not match the parsed one with flag %s and %s",
-					args[i].flag,
-					argTypeToString(args[i].type),
-					arg_parsed->flag,
-					argTypeToString(arg_parsed->type));
-			exit(1);
-		}
-
-		// Nargs check
-		if (args[i].type != ARG_BOOL && 
-				args[i].nargs > 0 &&
-				args[i].nargs != arg_parsed->data.array_string.count) {
-			nob_log(ERROR, "Declared argument with flag %s and nargs %d does not match the parsed one with flag %s and nargs %d",
-					args[i].flag,
-					args[i].nargs,
-					arg_parsed->flag,
-					arg_parsed->data.array_string.count
-				);
-			exit(1);
+			// Nargs check
+			if (args[i].type != ARG_BOOL && 
+					args[i].nargs > 0 &&
+					args[i].nargs != arg_parsed->data.array_string.count) {
+				argLogError("Declared argument with flag %s and nargs %d does not match the parsed one with flag %s and nargs %d",
+						args[i].flag,
+						args[i].nargs,
+						arg_parsed->flag,
+						arg_parsed->data.array_string.count
+					);
+				exit(1);
+			}
+			if (args[i].type != ARG_BOOL) total += arg_parsed->data.array_string.count;
 		}
 
 		// Assign based on type
-		if (args[i].type == ARG_STRING) {
-			args[i].data.array_string = arg_parsed->data.array_string;
-		} else if (args[i].type == ARG_LONG) {
-			args[i].data.array_long.count = 0;
-			da_foreach(char*, str, &arg_parsed->data.array_string) {
-				const char* tmp = *str;
-				for(size_t j = 0; j <strlen(tmp); j++) {
-					if ((!isdigit(tmp[j]) && !(j == 0 && tmp[j] == '-'))) {
-						nob_log(ERROR, "Declared argument with flag %s and type ARG_LONG does not match the parsed one with flag %s and argument %s",
-								args[i].flag,
-								arg_parsed->flag,
-				tmp
-							);
-						exit(1);
-					}
-				}
-
-				da_append(&args[i].data.array_long, atol(tmp));
-	  		}   
-		} else if (args[i].type == ARG_DOUBLE) {
-			args[i].data.array_double.count = 0;
-			da_foreach(char*, str, &arg_parsed->data.array_string) {
-				const char* tmp = *str;
-				bool dotfound = false;
-				for(size_t j = 0; j <strlen(tmp); j++) {
-					if ((!isdigit(tmp[j]) && !((j == 0 && tmp[j] == '-') || (!dotfound && tmp[j] == '.')))) {
-						printf("%c\n", tmp[j]);
-						nob_log(ERROR, "Declared argument with flag %s and type ARG_DOUBLE does not match the parsed one with flag %s and argument %s",
-								args[i].flag,
-								arg_parsed->flag,
-								tmp
-							);
-						exit(1);
-					}
-					if (tmp[j] == '.') dotfound = true;
-				}
-				da_append(&args[i].data.array_double, atof(tmp));
-	  		}
-		} else if (args[i].type == ARG_BOOL) {
+		Arg* arg_parsed = &args_parsed.items[parsed_index[i]];
+		if (args[i].type == ARG_BOOL) {
 			args[i].data.exists = arg_parsed->data.exists;
+		} else if (next[parsed_index[i]] == ARG_NO_TOKEN) {
+			ArrayOfStrings data = ownStrings(&args[i], arg_parsed->data.array_string, arena);
+			assignArgumentData(&args[i], argSchemaChoices(&schema, i), arg_parsed->flag, data, arena);
+		} else {
+			assignAccumulated(&args[i], argSchemaChoices(&schema, i), &args_parsed, parsed_index[i], next, total, arena);
 		}
 	}
+
+	// Heap results have their own arrays by now, nothing points into values
+	if (arena == NULL) {
+		free(tokens.items);
+		free(args_parsed.items);
+		free(values.items);
+		free(parsed_index);
+		free(next);
+		if (compiled == NULL) {
+			free(schema.sorted);
+			free(schema.enums);
+		}
+	}
+	ARG_PROBE2(done, argc, args_size);
+	return 0;
+}
+
+
+bool argParse(int argc, char** argv, Arg* args, size_t args_size)
+{
+	return parseWithArena(argc, argv, args, args_size, NULL, NULL, NULL);
+}
+
+
+bool argParseCompiled(int argc, char** argv, Arg* args, const ArgSchema* schema)
+{
+	return parseWithArena(argc, argv, args, schema->args_size, schema, NULL, NULL);
+}
+
+
+bool argParseKnown(int argc, char** argv, Arg* args, size_t args_size, ArgLeftovers* leftovers)
+{
+	*leftovers = (ArgLeftovers){0};
+	return parseWithArena(argc, argv, args, args_size, NULL, NULL, leftovers);
+}
+
+
+int argCompactLeftovers(int argc, char** argv, const ArgLeftovers* leftovers)
+{
+	// Ranges are ascending and start past argv[0], so w never passes them
+	int w = 1;
+	ARG_DA_FOREACH(ArgRange, r, &leftovers->unknown) {
+		for (size_t i = r->begin; i < r->end; i++) argv[w++] = argv[i];
+	}
+	// Keep the "--" so the next parser still sees a remainder
+	if (leftovers->separator) argv[w++] = argv[leftovers->remainder.begin - 1];
+	for (size_t i = leftovers->remainder.begin; i < leftovers->remainder.end; i++) {
+		argv[w++] = argv[i];
+	}
+	argv[w] = NULL;
+	return w;
+}
+
+
+void argLeftoversFree(ArgLeftovers* leftovers)
+{
+	ARG_DA_FREE(leftovers->unknown);
+	*leftovers = (ArgLeftovers){0};
+}
+
+
+bool argParseFixed(int argc, char** argv, Arg* args, size_t args_size, void* buffer, size_t buffer_size)
+{
+	size_t needed = ARG_PARSE_FIXED_SIZE(argc, args_size);
+	if (buffer_size < needed) {
+		argLogError("Fixed buffer of %zu bytes is smaller than the %zu bytes needed for %d arguments", buffer_size, needed, argc);
+		return 1;
+	}
+
+	ArgArena arena = { .base = buffer, .size = buffer_size, .used = 0 };
+	return parseWithArena(argc, argv, args, args_size, NULL, &arena, NULL);
+}
+
+
+bool argParseContextParse(ArgParseContext* ctx, int argc, char** argv, Arg* args, size_t args_size)
+{
+	size_t needed = ARG_PARSE_FIXED_SIZE(argc, args_size);
+	if (ctx->size < needed) {
+		size_t size = (2 * ctx->size > needed) ? 2 * ctx->size : needed;
+		free(ctx->buffer);
+		ctx->buffer = malloc(size);
+		ctx->size   = (ctx->buffer != NULL) ? size : 0;
+		ARG_ASSERT(ctx->buffer != NULL && "Buy more RAM lol");
+	}
+
+	// Results of the previous parse must not leak into this one
+	for (size_t i = 0; i < args_size; i++) {
+		memset(&args[i].data, 0, sizeof(args[i].data));
+	}
+
+	ArgArena arena = { .base = ctx->buffer, .size = ctx->size, .used = 0 };
+	return parseWithArena(argc, argv, args, args_size, NULL, &arena, NULL);
+}
+
+
+void argParseContextFree(ArgParseContext* ctx)
+{
+	free(ctx->buffer);
+	ctx->buffer = NULL;
+	ctx->size   = 0;
+}
+
+
+void argBoolBits(const Arg* args, size_t args_size, uint64_t* bits)
+{
+	memset(bits, 0, ARG_BITS_WORDS(args_size) * sizeof(uint64_t));
+	for (size_t i = 0; i < args_size; i++) {
+		if (args[i].type == ARG_BOOL && args[i].data.exists) bits[i / 64] |= ARG_BIT(i);
+	}
 }
@@ -0,0 +1,138 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Helpers shared between the source files of the library. Not installed
+// and not part of the public argparse.h interface.
+
+#ifndef ARGPARSE_INTERNAL_H_
+#define ARGPARSE_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "argparse.h"
+
+// Token classification used by tokenizeArguments.
+ArgTokenType argClassifyToken(const char* str);
+
+// Groups tokens into one Arg per flag, the data of every flag is appended
+// to values, which must be reserved for every data token.
+bool parseArguments(const ArgTokens* tokens, Args* args_parsed, ArrayOfStrings* values);
+
+// Declared arguments whose flag does not start with "--" are positional.
+bool argIsPositional(const Arg* arg);
+
+// Validates the declared positional arguments for count leading values.
+// Returns how many of them the fixed .nargs positionals take, the rest
+// goes to *variadic (NULL when there is none).
+size_t argPositionalLayout(const Arg* args, size_t args_size, size_t count, const Arg** variadic);
+
+void displayHelp(Arg* args, size_t args_size);
+
+// argParse and argCompleteCommand with the schema of args compiled by the
+// caller, e.g. the cached one of an ArgCommand. argCompleteSchema exits.
+bool argParseCompiled(int argc, char** argv, Arg* args, const ArgSchema* schema);
+void argCompleteSchema(const ArgSchema* schema, int argc, char** argv);
+
+// Numeric argument types: everything but ARG_BOOL and ARG_STRING. ARG_ENUM
+// is stored as int32_t indices.
+bool   argIsNumeric(ArgType type);
+size_t argTypeSize(ArgType type);
+
+// Items of the numeric array of arg, untyped.
+void*  argNumbers(const Arg* arg, size_t* count, size_t* capacity);
+void   argSetNumbers(Arg* arg, void* items, size_t count, size_t capacity);
+
+// Converts one token of a numeric type into *dst (a value of the C type
+// of the type), range checked. Returns false when str is not valid.
+// argConvertSpan reads exactly size bytes and needs no terminator.
+// choices is the compiled hash of an ARG_ENUM and unused otherwise.
+bool   argConvertValue(ArgType type, const ArgEnumHash* choices, const char* str, void* dst);
+bool   argConvertSpan(ArgType type, const ArgEnumHash* choices, const char* str, size_t size, void* dst);
+
+// Locale independent, correctly rounded conversion of the size bytes of
+// an ARG_DOUBLE token. Returns false when they are not a valid number.
+bool argParseDouble(const char* str, size_t size, double* out);
+
+// argSchemaCompile into caller provided storage of args_size entries,
+// enums may be NULL when argHasEnums is false.
+bool argSchemaCompileInto(ArgSchema* schema, const Arg* args, size_t args_size, ArgSchemaEntry* sorted, ArgEnumHash* enums);
+
+// Hash of the ARG_ENUM at index i of the schema, NULL for other types.
+const ArgEnumHash* argSchemaChoices(const ArgSchema* schema, size_t i);
+
+// Perfect hash of the choices of an ARG_ENUM declaration. Returns 1 when
+// they are missing, too many or duplicated.
+bool argHasEnums(const Arg* args, size_t args_size);
+bool argEnumCompile(const Arg* arg, ArgEnumHash* hash);
+
+// Index of the choice equal to the size bytes of str, false when none is.
+bool argEnumFind(const ArgEnumHash* hash, const char* str, size_t size, int32_t* out);
+
+// "@bin:path" value of a numeric argument declared with .binary.
+// argMapBinary maps the file as the values of arg, it returns 1 after
+// logging when it can not.
+bool argIsBinValue(const char* value);
+bool argMapBinary(Arg* arg, const char* parsed_flag, const char* value);
+
+// "first..last[:step]" value of an ARG_LONG/ARG_DOUBLE declared with
+// .range. argParseSequence returns false when value is not a valid non
+// empty range of type.
+bool argIsSequenceValue(const char* value);
+bool argParseSequence(ArgType type, const char* value, ArgSequence* out);
+
+// Results kept as an ArgSequence, and a copy of the values of any
+// numeric result into dst whichever way it is stored.
+bool argIsSequence(const Arg* arg);
+void argCopyNumbers(const Arg* arg, void* dst);
+
+// FNV-1a of size bytes and a finalizer spreading it for masking, seeded
+// so one hash of a string yields many independent ones.
+uint32_t argHashBytes(const char* str, size_t size);
+uint32_t argHashMix(uint32_t h, uint32_t seed);
+
+// Binary search over ArgSchema.sorted comparing the first n bytes.
+size_t argSchemaLowerBound(const ArgSchema* schema, const char* key, size_t n);
+
+// Converts count numeric strings into dst with argConvertValue, in
+// parallel above the threshold of argSetParallelConversion when parallel
+// is set. Parses that must not allocate pass false, starting the worker
+// threads allocates. Returns the lowest index that is not a valid number,
+// count when all are.
+size_t argConvertNumbers(ArgType type, const ArgEnumHash* choices, char** values, size_t count, void* dst, bool parallel);
+
+// Bump allocator over a caller provided buffer, used by argParseFixed.
+// argArenaAlloc returns NULL once the buffer is exhausted.
+typedef struct {
+	char*  base;
+	size_t size;
+	size_t used;
+} ArgArena;
+
+void* argArenaAlloc(ArgArena* arena, size_t size);
+
+// Replaces the count ARG_STRING values of arg by ids into a table of the
+// distinct ones, see ArgInterned. Allocates from the arena when one is
+// given.
+void argInternStrings(Arg* arg, char** values, size_t count, ArgArena* arena);
+
+#endif // ARGPARSE_INTERNAL_H_
@@ -0,0 +1,175 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// In place heapsort: no allocation and O(n log n) in the worst case,
+// unlike qsort which may allocate a merge buffer.
+static void siftSchemaEntry(ArgSchemaEntry* items, size_t root, size_t n)
+{
+	while (2 * root + 1 < n) {
+		size_t child = 2 * root + 1;
+		if (child + 1 < n && strcmp(items[child].flag, items[child + 1].flag) < 0) child++;
+		if (strcmp(items[root].flag, items[child].flag) >= 0) return;
+		ArgSchemaEntry tmp = items[root];
+		items[root]  = items[child];
+		items[child] = tmp;
+		root = child;
+	}
+}
+
+
+static void sortSchemaEntries(ArgSchemaEntry* items, size_t n)
+{
+	for (size_t i = n / 2; i-- > 0;) {
+		siftSchemaEntry(items, i, n);
+	}
+	for (size_t i = n; i-- > 1;) {
+		ArgSchemaEntry tmp = items[0];
+		items[0] = items[i];
+		items[i] = tmp;
+		siftSchemaEntry(items, 0, i);
+	}
+}
+
+
+bool argSchemaCompileInto(ArgSchema* schema, const Arg* args, size_t args_size, ArgSchemaEntry* sorted, ArgEnumHash* enums)
+{
+	memset(schema, 0, sizeof(*schema));
+	schema->args      = args;
+	schema->args_size = args_size;
+	schema->sorted    = sorted;
+	schema->enums     = enums;
+
+	for (size_t i = 0; i < args_size; i++) {
+		schema->sorted[i].flag  = args[i].flag;
+		schema->sorted[i].index = i;
+	}
+	sortSchemaEntries(schema->sorted, args_size);
+
+	for (size_t i = 1; i < args_size; i++) {
+		if (!strcmp(schema->sorted[i - 1].flag, schema->sorted[i].flag)) {
+			argLogError("Duplicate flags %s declared. Please declare each flags only 1 time.", schema->sorted[i].flag);
+			return 1;
+		}
+	}
+
+	for (size_t i = 0; i < args_size; i++) {
+		if (args[i].type == ARG_ENUM && argEnumCompile(&args[i], &enums[i])) return 1;
+	}
+	return 0;
+}
+
+
+const ArgEnumHash* argSchemaChoices(const ArgSchema* schema, size_t i)
+{
+	if (schema->args[i].type != ARG_ENUM) return NULL;
+	return &schema->enums[i];
+}
+
+
+bool argSchemaCompile(ArgSchema* schema, const Arg* args, size_t args_size)
+{
+	ArgSchemaEntry* sorted = malloc((args_size + 1) * sizeof(ArgSchemaEntry));
+	if (sorted == NULL) {
+		argLogError("Could not allocate the schema of %zu arguments", args_size);
+		return 1;
+	}
+	ArgEnumHash* enums = NULL;
+	if (argHasEnums(args, args_size)) {
+		enums = malloc(args_size * sizeof(ArgEnumHash));
+		if (enums == NULL) {
+			free(sorted);
+			argLogError("Could not allocate the schema of %zu arguments", args_size);
+			return 1;
+		}
+	}
+	if (argSchemaCompileInto(schema, args, args_size, sorted, enums)) {
+		free(sorted);
+		free(enums);
+		memset(schema, 0, sizeof(*schema));
+		return 1;
+	}
+	return 0;
+}
+
+
+void argSchemaFree(ArgSchema* schema)
+{
+	free(schema->sorted);
+	free(schema->enums);
+	memset(schema, 0, sizeof(*schema));
+}
+
+
+// First sorted entry whose flag is not smaller than the first n bytes of
+// key, n = (size_t)-1 compares whole strings.
+size_t argSchemaLowerBound(const ArgSchema* schema, const char* key, size_t n)
+{
+	size_t lo = 0;
+	size_t hi = schema->args_size;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		int cmp = (n == (size_t)-1) ? strcmp(schema->sorted[mid].flag, key) : strncmp(schema->sorted[mid].flag, key, n);
+		if (cmp < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+
+size_t argSchemaFind(const ArgSchema* schema, const char* flag)
+{
+	size_t i = argSchemaLowerBound(schema, flag, (size_t)-1);
+	if (i < schema->args_size && !strcmp(schema->sorted[i].flag, flag)) return schema->sorted[i].index;
+	return ARG_NO_TOKEN;
+}
+
+
+size_t argSchemaHandle(const ArgSchema* schema, const char* flag)
+{
+	size_t handle = argSchemaFind(schema, flag);
+	if (handle == ARG_NO_TOKEN) {
+		argLogError("No argument with flag %s is declared", flag);
+		exit(1);
+	}
+	return handle;
+}
+
+
+size_t argCount(const Arg* args, size_t handle)
+{
+	const Arg* arg = &args[handle];
+	if (arg->type == ARG_BOOL) return arg->data.exists;
+	if (arg->type == ARG_STRING && arg->intern) return arg->data.interned.count;
+	if (arg->type == ARG_STRING) return arg->data.array_string.count;
+
+	size_t count;
+	argNumbers(arg, &count, NULL);
+	return count;
+}
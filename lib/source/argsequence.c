@@ -0,0 +1,156 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// "first..last[:step]" tokens of ARG_LONG/ARG_DOUBLE declared with .range,
+// other flags reject them as invalid numbers. The values are
+// first + i * step up to last included, so a range costs two or three
+// conversions however many values it stands for. step defaults to 1, or
+// -1 when last is below first.
+
+// Double ranges end within this fraction of a step from last, so that
+// 0..0.3:0.1 ends at 0.3 like seq does.
+#define SEQUENCE_TOLERANCE 1e-9
+
+// Double sequences beyond 2^53 values can not tell values apart. Both
+// kinds are also limited to counts whose array size fits in a size_t, so
+// materializing or copying them never wraps.
+#define SEQUENCE_MAX_DOUBLES 9007199254740992.0
+
+bool argIsSequenceValue(const char* value)
+{
+	return strstr(value, "..") != NULL;
+}
+
+
+static bool sequenceLongs(const char* str, const char* dots, const char* colon, const char* end, ArgSequence* out)
+{
+	long first, last, step;
+	if (!argConvertSpan(ARG_LONG, NULL, str, (size_t)(dots - str), &first)) return false;
+	if (!argConvertSpan(ARG_LONG, NULL, dots + 2, (size_t)(colon - dots - 2), &last)) return false;
+	if (colon == end) {
+		step = (last < first) ? -1 : 1;
+	} else if (!argConvertSpan(ARG_LONG, NULL, colon + 1, (size_t)(end - colon - 1), &step)) {
+		return false;
+	}
+	if (step == 0 || (step > 0 && last < first) || (step < 0 && last > first)) return false;
+
+	// Distances and steps in unsigned arithmetic never overflow
+	uint64_t distance  = (step > 0) ? (uint64_t)last - (uint64_t)first : (uint64_t)first - (uint64_t)last;
+	uint64_t magnitude = (step > 0) ? (uint64_t)step : 0 - (uint64_t)step;
+	uint64_t count     = distance / magnitude + 1;
+	if (count == 0 || count > SIZE_MAX / sizeof(long)) return false;
+
+	out->count   = (size_t)count;
+	out->first.l = first;
+	out->step.l  = step;
+	return true;
+}
+
+
+static bool sequenceDoubles(const char* str, const char* dots, const char* colon, const char* end, ArgSequence* out)
+{
+	double first, last, step;
+	if (!argParseDouble(str, (size_t)(dots - str), &first)) return false;
+	if (!argParseDouble(dots + 2, (size_t)(colon - dots - 2), &last)) return false;
+	if (colon == end) {
+		step = (last < first) ? -1 : 1;
+	} else if (!argParseDouble(colon + 1, (size_t)(end - colon - 1), &step)) {
+		return false;
+	}
+	if (!isfinite(first) || !isfinite(last) || !isfinite(step) || step == 0) return false;
+	if ((step > 0 && last < first) || (step < 0 && last > first)) return false;
+
+	// Not negative, the conversion truncates it to whole steps
+	double steps = (last - first) / step + SEQUENCE_TOLERANCE;
+	if (!(steps < SEQUENCE_MAX_DOUBLES) || !(steps < (double)(SIZE_MAX / sizeof(double)))) return false;
+
+	out->count   = (size_t)steps + 1;
+	out->first.d = first;
+	out->step.d  = step;
+	return true;
+}
+
+
+bool argParseSequence(ArgType type, const char* value, ArgSequence* out)
+{
+	const char* end   = value + strlen(value);
+	const char* dots  = strstr(value, "..");
+	if (dots == NULL) return false;
+	const char* colon = strchr(dots + 2, ':');
+	if (colon == NULL) colon = end;
+
+	memset(out, 0, sizeof(*out));
+	if (type == ARG_LONG)   return sequenceLongs(value, dots, colon, end, out);
+	if (type == ARG_DOUBLE) return sequenceDoubles(value, dots, colon, end, out);
+	return false;
+}
+
+
+bool argIsSequence(const Arg* arg)
+{
+	if (!arg->range || (arg->type != ARG_LONG && arg->type != ARG_DOUBLE)) return false;
+	return arg->data.sequence.items == NULL && arg->data.sequence.count > 0;
+}
+
+
+void argCopyNumbers(const Arg* arg, void* dst)
+{
+	size_t count;
+	void*  items = argNumbers(arg, &count, NULL);
+	if (!argIsSequence(arg)) {
+		if (count > 0) memcpy(dst, items, count * argTypeSize(arg->type));
+		return;
+	}
+	for (size_t i = 0; i < count; i++) {
+		if (arg->type == ARG_LONG) {
+			((long*)dst)[i] = argLong(arg, 0, i);
+		} else {
+			((double*)dst)[i] = argDouble(arg, 0, i);
+		}
+	}
+}
+
+
+void argMaterialize(Arg* args, size_t handle)
+{
+	Arg* arg = &args[handle];
+	if (!argIsSequence(arg)) return;
+
+	size_t count = arg->data.sequence.count;
+	size_t size  = argTypeSize(arg->type);
+	if (count > SIZE_MAX / size) {
+		argLogError("Range of %s has %zu values, too many to store", arg->flag, count);
+		exit(1);
+	}
+	void*  items = ARG_REALLOC(NULL, count * size);
+	ARG_ASSERT(items != NULL && "Buy more RAM lol");
+	argCopyNumbers(arg, items);
+	argSetNumbers(arg, items, count, count);
+}
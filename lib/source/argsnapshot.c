@@ -0,0 +1,237 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// Readers announce the epoch they entered at in their own slot and then
+// load the current snapshot. The writer swaps the pointer, bumps the epoch
+// and frees a retired snapshot only once no reader slot holds an epoch
+// older than the one it was retired at. All atomics are sequentially
+// consistent, the slot store must not be reordered with the pointer load.
+
+static size_t alignUp(size_t n, size_t alignment)
+{
+	return (n + alignment - 1) / alignment * alignment;
+}
+
+
+static char* snapshotCopySpan(char** cursor, ArgSpan span)
+{
+	char* dst = *cursor;
+	memcpy(dst, span.data, span.size);
+	dst[span.size] = '\0';
+	*cursor += span.size + 1;
+	return dst;
+}
+
+
+static char* snapshotCopyString(char** cursor, const char* str)
+{
+	if (str == NULL) return NULL;
+	return snapshotCopySpan(cursor, (ArgSpan){ str, strlen(str) });
+}
+
+
+ArgSnapshot* argSnapshotCreate(const Arg* args, size_t args_size)
+{
+	// Layout: ArgSnapshot | Arg[] | bool bits | numeric values | char*[] | string bytes
+	size_t numbers  = 0;
+	size_t pointers = 0;
+	size_t bytes    = 0;
+	for (size_t i = 0; i < args_size; i++) {
+		bytes += strlen(args[i].flag) + 1;
+		if (args[i].help != NULL) bytes += strlen(args[i].help) + 1;
+
+		if (args[i].type == ARG_STRING) {
+			pointers += argCount(args, i);
+			for (size_t j = 0; j < argCount(args, i); j++) {
+				bytes += argSpan(args, i, j).size + 1;
+			}
+		} else if (argIsNumeric(args[i].type) && !argIsSequence(&args[i])) {
+			// Every numeric element type is aligned to its own size
+			size_t size = argTypeSize(args[i].type);
+			size_t count;
+			argNumbers(&args[i], &count, NULL);
+			numbers = alignUp(numbers, size) + count * size;
+		}
+	}
+
+	size_t args_offset     = alignUp(sizeof(ArgSnapshot), _Alignof(Arg));
+	size_t bits_offset     = alignUp(args_offset + args_size * sizeof(Arg), _Alignof(uint64_t));
+	size_t numbers_offset  = alignUp(bits_offset + ARG_BITS_WORDS(args_size) * sizeof(uint64_t), _Alignof(max_align_t));
+	size_t pointers_offset = alignUp(numbers_offset + numbers, _Alignof(char*));
+	size_t bytes_offset    = pointers_offset + pointers * sizeof(char*);
+
+	char* base = malloc(bytes_offset + bytes);
+	if (base == NULL) {
+		argLogError("Could not allocate a snapshot of %zu bytes", bytes_offset + bytes);
+		return NULL;
+	}
+
+	ArgSnapshot* snapshot = (ArgSnapshot*)base;
+	snapshot->args      = (Arg*)(base + args_offset);
+	snapshot->args_size = args_size;
+	snapshot->bits      = (uint64_t*)(base + bits_offset);
+	argBoolBits(args, args_size, snapshot->bits);
+
+	size_t number_cursor  = numbers_offset;
+	char** pointer_cursor = (char**)(base + pointers_offset);
+	char*  byte_cursor    = base + bytes_offset;
+
+	for (size_t i = 0; i < args_size; i++) {
+		Arg* dst = &snapshot->args[i];
+		*dst = args[i];
+		dst->flag = snapshotCopyString(&byte_cursor, args[i].flag);
+		dst->help = snapshotCopyString(&byte_cursor, args[i].help);
+
+		if (args[i].type == ARG_STRING) {
+			// Interned values and spans are stored as strings
+			size_t count = argCount(args, i);
+			dst->intern = false;
+			dst->spans  = false;
+			dst->data.array_string = (ArrayOfStrings){ .items = pointer_cursor, .count = count, .capacity = count };
+			for (size_t j = 0; j < count; j++) {
+				pointer_cursor[j] = snapshotCopySpan(&byte_cursor, argSpan(args, i, j));
+			}
+			pointer_cursor += count;
+		} else if (argIsNumeric(args[i].type) && !argIsSequence(&args[i])) {
+			// Ranges stay generators, the copy of the Arg holds them
+			size_t size = argTypeSize(args[i].type);
+			size_t count;
+			void*  items = argNumbers(&args[i], &count, NULL);
+			number_cursor = alignUp(number_cursor, size);
+			argSetNumbers(dst, base + number_cursor, count, count);
+			if (count > 0) memcpy(base + number_cursor, items, count * size);
+			number_cursor += count * size;
+		}
+	}
+
+	return snapshot;
+}
+
+
+void argSnapshotFree(ArgSnapshot* snapshot)
+{
+	free(snapshot);
+}
+
+
+bool argSnapshotCellInit(ArgSnapshotCell* cell, size_t max_readers)
+{
+	memset(cell, 0, sizeof(*cell));
+	atomic_init(&cell->current, NULL);
+	atomic_init(&cell->epoch, 0);
+	atomic_init(&cell->readers_used, 0);
+
+	if (max_readers == 0) return 0;
+	cell->readers = aligned_alloc(sizeof(ArgSnapshotReader), max_readers * sizeof(ArgSnapshotReader));
+	if (cell->readers == NULL) {
+		argLogError("Could not allocate %zu snapshot reader slots", max_readers);
+		return 1;
+	}
+	cell->readers_count = max_readers;
+	for (size_t i = 0; i < max_readers; i++) {
+		atomic_init(&cell->readers[i].epoch, ARG_SNAPSHOT_IDLE);
+	}
+	return 0;
+}
+
+
+void argSnapshotCellFree(ArgSnapshotCell* cell)
+{
+	ARG_DA_FOREACH(ArgRetiredSnapshot, r, &cell->retired) {
+		argSnapshotFree(r->snapshot);
+	}
+	ARG_DA_FREE(cell->retired);
+	argSnapshotFree(atomic_load(&cell->current));
+	free(cell->readers);
+	memset(cell, 0, sizeof(*cell));
+}
+
+
+void argSnapshotPublish(ArgSnapshotCell* cell, ArgSnapshot* snapshot)
+{
+	ArgSnapshot* old = atomic_exchange(&cell->current, snapshot);
+	size_t epoch = atomic_fetch_add(&cell->epoch, 1) + 1;
+	if (old != NULL) {
+		ArgRetiredSnapshot r = { .snapshot = old, .epoch = epoch };
+		ARG_DA_APPEND(&cell->retired, r);
+	}
+	argSnapshotReclaim(cell);
+}
+
+
+size_t argSnapshotReclaim(ArgSnapshotCell* cell)
+{
+	size_t used = atomic_load(&cell->readers_used);
+	if (used > cell->readers_count) used = cell->readers_count;
+
+	size_t oldest = ARG_SNAPSHOT_IDLE;
+	for (size_t i = 0; i < used; i++) {
+		size_t epoch = atomic_load(&cell->readers[i].epoch);
+		if (epoch < oldest) oldest = epoch;
+	}
+
+	// A reader that entered at epoch e may still hold any snapshot retired
+	// at an epoch greater than e.
+	size_t freed = 0;
+	size_t kept  = 0;
+	for (size_t i = 0; i < cell->retired.count; i++) {
+		ArgRetiredSnapshot r = cell->retired.items[i];
+		if (r.epoch <= oldest) {
+			argSnapshotFree(r.snapshot);
+			freed++;
+		} else {
+			cell->retired.items[kept++] = r;
+		}
+	}
+	cell->retired.count = kept;
+	return freed;
+}
+
+
+ArgSnapshotReader* argSnapshotReaderRegister(ArgSnapshotCell* cell)
+{
+	size_t i = atomic_fetch_add(&cell->readers_used, 1);
+	if (i >= cell->readers_count) {
+		argLogError("All %zu snapshot reader slots are taken", cell->readers_count);
+		return NULL;
+	}
+	return &cell->readers[i];
+}
+
+
+const ArgSnapshot* argSnapshotReadBegin(ArgSnapshotCell* cell, ArgSnapshotReader* reader)
+{
+	atomic_store(&reader->epoch, atomic_load(&cell->epoch));
+	return atomic_load(&cell->current);
+}
+
+
+void argSnapshotReadEnd(ArgSnapshotReader* reader)
+{
+	atomic_store(&reader->epoch, ARG_SNAPSHOT_IDLE);
+}
@@ -0,0 +1,208 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// argParse for length delimited input: every comparison and conversion
+// works on the span sizes, nothing is copied or needs a terminator. The
+// ARG_STRING results are ArgSpans in .data.array_span, marked by .spans so
+// the accessors and copies do not read them as strings. Positional ones
+// point into the input array, the others into one exactly sized array
+// per flag, so the input spans must outlive the results. Declarations
+// with .intern, .range or .binary are rejected rather than parsed with
+// other rules than argParse: they would need NUL terminated copies.
+
+static bool spanIsFlag(ArgSpan span)
+{
+	return span.size >= 2 && span.data[0] == '-' && span.data[1] == '-';
+}
+
+
+static size_t spanFind(const ArgSchema* schema, ArgSpan flag)
+{
+	size_t i = argSchemaLowerBound(schema, flag.data, flag.size);
+	if (i >= schema->args_size) return ARG_NO_TOKEN;
+
+	const char* declared = schema->sorted[i].flag;
+	size_t n = 0;
+	while (n < flag.size && declared[n] != '\0' && declared[n] == flag.data[n]) n++;
+	if (n == flag.size && declared[n] == '\0') return schema->sorted[i].index;
+	return ARG_NO_TOKEN;
+}
+
+
+// Allocates the result array of arg for total values, count 0
+static void spanReserve(Arg* arg, size_t total)
+{
+	size_t size = (arg->type == ARG_STRING) ? sizeof(ArgSpan) : argTypeSize(arg->type);
+	void* items = NULL;
+	if (total > 0) {
+		items = ARG_REALLOC(NULL, total * size);
+		ARG_ASSERT(items != NULL && "Buy more RAM lol");
+	}
+	if (arg->type == ARG_STRING) {
+		arg->data.array_span = (ArrayOfSpans){ .items = items, .count = 0, .capacity = total };
+	} else {
+		argSetNumbers(arg, items, 0, total);
+	}
+}
+
+
+// Appends n values given after flag to the reserved result of arg
+static void spanAssign(Arg* arg, const ArgEnumHash* choices, ArgSpan flag, const ArgSpan* values, size_t n)
+{
+	if (arg->type == ARG_STRING) {
+		ArrayOfSpans* spans = &arg->data.array_span;
+		memcpy(spans->items + spans->count, values, n * sizeof(ArgSpan));
+		spans->count += n;
+		return;
+	}
+
+	size_t count, capacity;
+	char*  items = argNumbers(arg, &count, &capacity);
+	size_t size  = argTypeSize(arg->type);
+	for (size_t i = 0; i < n; i++) {
+		if (!argConvertSpan(arg->type, choices, values[i].data, values[i].size, items + (count + i) * size)) {
+			argLogError("Declared argument with flag %s and type %s does not match the parsed one with flag %.*s and argument %.*s",
+					arg->flag,
+					argTypeToString(arg->type),
+					(int)flag.size, flag.data,
+					(int)values[i].size, values[i].data
+				);
+			exit(1);
+		}
+	}
+	argSetNumbers(arg, items, count + n, capacity);
+}
+
+
+bool argParseSpans(const ArgSpan* spans, size_t count, Arg* args, size_t args_size)
+{
+	ARG_PROBE2(start, count, args_size);
+	if (count == 1 && spans[0].size == 6 && !memcmp(spans[0].data, "--help", 6)) {
+		displayHelp(args, args_size);
+		return 0;
+	}
+
+	ArgSchema schema;
+	if (argSchemaCompile(&schema, args, args_size)) exit(1);
+	for (size_t i = 0; i < args_size; i++) {
+		if (args[i].type == ARG_STRING && args[i].intern) {
+			argLogError("Argument %s is declared with .intern, which length delimited input does not support", args[i].flag);
+			exit(1);
+		}
+		if (args[i].range || args[i].binary) {
+			argLogError("Argument %s is declared with .%s, which length delimited input does not support",
+					args[i].flag, args[i].range ? "range" : "binary");
+			exit(1);
+		}
+		args[i].spans = args[i].type == ARG_STRING;
+	}
+
+	size_t positionals = 0;
+	while (positionals < count && !spanIsFlag(spans[positionals])) positionals++;
+
+	// First pass: validate every occurrence and count the values of each
+	// declared argument, owner[i] is the declaration of the flag at i.
+	size_t* owner       = ARG_REALLOC(NULL, (count + 1) * sizeof(size_t));
+	size_t* occurrences = calloc(args_size + 1, sizeof(size_t));
+	size_t* totals      = calloc(args_size + 1, sizeof(size_t));
+	ARG_ASSERT(owner != NULL && occurrences != NULL && totals != NULL && "Buy more RAM lol");
+
+	for (size_t i = positionals; i < count;) {
+		ArgSpan flag = spans[i];
+		size_t declared = spanFind(&schema, flag);
+		if (declared == ARG_NO_TOKEN) {
+			argLogError("Undeclared argument flag %.*s provided please declared it as an input argument", (int)flag.size, flag.data);
+			exit(1);
+		}
+
+		size_t n = 0;
+		while (i + 1 + n < count && !spanIsFlag(spans[i + 1 + n])) n++;
+
+		const Arg* arg = &args[declared];
+		if (occurrences[declared]++ > 0 && !arg->append) {
+			argLogError("Duplicate flags %s provided", arg->flag);
+			exit(1);
+		}
+		if ((arg->type == ARG_BOOL) != (n == 0)) {
+			argLogError("Declared argument with flag %s and type %s does not match the parsed one with flag %s and %s",
+					arg->flag,
+					argTypeToString(arg->type),
+					arg->flag,
+					argTypeToString(n == 0 ? ARG_BOOL : ARG_STRING));
+			exit(1);
+		}
+		if (arg->type != ARG_BOOL && arg->nargs > 0 && arg->nargs != n) {
+			argLogError("Declared argument with flag %s and nargs %zu does not match the parsed one with flag %s and nargs %zu",
+					arg->flag, arg->nargs, arg->flag, n);
+			exit(1);
+		}
+		owner[i]         = declared;
+		totals[declared] += n;
+		i += 1 + n;
+	}
+
+	const Arg* variadic;
+	size_t fixed = argPositionalLayout(args, args_size, positionals, &variadic);
+	size_t at    = 0;
+	for (size_t i = 0; i < args_size; i++) {
+		Arg* arg = &args[i];
+		if (argIsPositional(arg)) {
+			size_t n = (arg == variadic) ? positionals - fixed : arg->nargs;
+			if (arg->type == ARG_STRING) {
+				arg->data.array_span = (ArrayOfSpans){ .items = (ArgSpan*)spans + at, .count = n, .capacity = 0 };
+			} else {
+				spanReserve(arg, n);
+				spanAssign(arg, argSchemaChoices(&schema, i), (ArgSpan){ arg->flag, strlen(arg->flag) }, spans + at, n);
+			}
+			at += n;
+		} else if (occurrences[i] == 0) {
+			if (arg->required && arg->type != ARG_BOOL) {
+				argLogError("Input argument %s is required and it is not provided", arg->flag);
+				exit(1);
+			}
+		} else if (arg->type == ARG_BOOL) {
+			arg->data.exists = true;
+		} else {
+			spanReserve(arg, totals[i]);
+		}
+	}
+
+	// Second pass: values in command line order, repeated .append flags
+	// land behind each other in the array reserved above.
+	for (size_t i = positionals; i < count;) {
+		size_t n = 0;
+		while (i + 1 + n < count && !spanIsFlag(spans[i + 1 + n])) n++;
+		if (n > 0) spanAssign(&args[owner[i]], argSchemaChoices(&schema, owner[i]), spans[i], spans + i + 1, n);
+		i += 1 + n;
+	}
+
+	free(owner);
+	free(occurrences);
+	free(totals);
+	argSchemaFree(&schema);
+	ARG_PROBE2(done, count, args_size);
+	return 0;
+}
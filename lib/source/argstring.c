@@ -0,0 +1,191 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <limits.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define ARG_STRING_SSE2
+#endif
+
+// Command strings are split like a POSIX shell without expansions:
+// whitespace separates words, '...' is literal, inside "..." a backslash
+// only escapes " and \, and outside of quotes it escapes any character.
+// Unquoting shortens a word, so it is compacted towards its start and
+// the write position never passes the read position. Runs of ordinary
+// bytes are skipped 16 at a time with SSE2 compares and a movemask.
+
+typedef struct {
+	char** items;
+	size_t count;
+	size_t capacity;
+} StringArgv;
+
+
+static bool isSpace(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+// First index in [i, len) holding whitespace, a quote or a backslash
+static size_t skipPlain(const char* s, size_t i, size_t len)
+{
+#ifdef ARG_STRING_SSE2
+	const __m128i space  = _mm_set1_epi8(' ');
+	const __m128i dquote = _mm_set1_epi8('"');
+	const __m128i squote = _mm_set1_epi8('\'');
+	const __m128i escape = _mm_set1_epi8('\\');
+	const __m128i below  = _mm_set1_epi8('\t' - 1);
+	const __m128i above  = _mm_set1_epi8('\r' + 1);
+	for (; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+		__m128i m = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, space));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, dquote));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, squote));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, escape));
+		int mask = _mm_movemask_epi8(m);
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+#endif
+	while (i < len && !isSpace(s[i]) && s[i] != '"' && s[i] != '\'' && s[i] != '\\') i++;
+	return i;
+}
+
+
+// First index in [i, len) holding a double quote or a backslash
+static size_t skipDoubleQuoted(const char* s, size_t i, size_t len)
+{
+#ifdef ARG_STRING_SSE2
+	const __m128i dquote = _mm_set1_epi8('"');
+	const __m128i escape = _mm_set1_epi8('\\');
+	for (; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+		int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, dquote), _mm_cmpeq_epi8(v, escape)));
+		if (mask != 0) return i + __builtin_ctz(mask);
+	}
+#endif
+	while (i < len && s[i] != '"' && s[i] != '\\') i++;
+	return i;
+}
+
+
+// Moves s[from, to) down to s[*w] and advances *w
+static void keep(char* s, size_t* w, size_t from, size_t to)
+{
+	if (*w != from) memmove(s + *w, s + from, to - from);
+	*w += to - from;
+}
+
+
+static bool splitString(char* s, StringArgv* argv)
+{
+	size_t len = strlen(s);
+	size_t r   = 0;
+	for (;;) {
+		while (r < len && isSpace(s[r])) r++;
+		if (r >= len) return 0;
+
+		size_t word = r;
+		size_t w    = r;
+		for (;;) {
+			size_t e = skipPlain(s, r, len);
+			keep(s, &w, r, e);
+			r = e;
+			if (r >= len || isSpace(s[r])) break;
+
+			char c = s[r++];
+			if (c == '\\') {
+				if (r >= len) {
+					argLogError("Trailing \\ at the end of the command string");
+					return 1;
+				}
+				s[w++] = s[r++];
+			} else if (c == '\'') {
+				const char* q = memchr(s + r, '\'', len - r);
+				if (q == NULL) {
+					argLogError("Unterminated ' quote at offset %zu of the command string", r - 1);
+					return 1;
+				}
+				keep(s, &w, r, q - s);
+				r = q - s + 1;
+			} else {
+				size_t open = r - 1;
+				for (;;) {
+					e = skipDoubleQuoted(s, r, len);
+					keep(s, &w, r, e);
+					r = e;
+					if (r >= len) {
+						argLogError("Unterminated \" quote at offset %zu of the command string", open);
+						return 1;
+					}
+					if (s[r++] == '"') break;
+					s[w++] = (r < len && (s[r] == '"' || s[r] == '\\')) ? s[r++] : '\\';
+				}
+			}
+		}
+
+		bool more = r < len;
+		s[w] = '\0';
+		ARG_DA_APPEND(argv, s + word);
+		if (!more) return 0;
+		r++;
+	}
+}
+
+
+bool argParseString(char* buffer, Arg* args, size_t args_size)
+{
+	// argv[0] is the program name, which the parser skips
+	StringArgv argv = {0};
+	ARG_DA_APPEND(&argv, "");
+	if (splitString(buffer, &argv)) {
+		ARG_DA_FREE(argv);
+		return 1;
+	}
+	if (argv.count > INT_MAX) {
+		argLogError("Command string has %zu words, more than an argc can hold", argv.count - 1);
+		ARG_DA_FREE(argv);
+		return 1;
+	}
+
+	bool failed = argParse((int)argv.count, argv.items, args, args_size);
+
+	// Positional ARG_STRING results are spans of argv: they get arrays of
+	// their own, owned by the caller like flag results, and argv goes. The
+	// strings themselves stay in the buffer.
+	for (size_t i = 0; !failed && i < args_size; i++) {
+		ArrayOfStrings* values = &args[i].data.array_string;
+		if (!argIsPositional(&args[i]) || args[i].type != ARG_STRING || args[i].intern) continue;
+		if (values->items < argv.items || values->items >= argv.items + argv.count) continue;
+		char** items = ARG_REALLOC(NULL, (values->count + 1) * sizeof(char*));
+		ARG_ASSERT(items != NULL && "Buy more RAM lol");
+		memcpy(items, values->items, values->count * sizeof(char*));
+		*values = (ArrayOfStrings){ .items = items, .count = values->count, .capacity = values->count };
+	}
+	ARG_DA_FREE(argv);
+	return failed;
+}
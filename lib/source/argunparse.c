@@ -0,0 +1,185 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <stdint.h>
+#include <string.h>
+#include "argcore.h"
+#include "argparse.h"
+#include "argparse_internal.h"
+
+// Longest text of one value of a numeric type, terminator included
+static size_t unparseWidth(ArgType type)
+{
+	switch (type) {
+	case ARG_DOUBLE: return sizeof("-2.2250738585072014e-308");
+	case ARG_FLOAT:  return sizeof("-1.17549435e-38");
+	default:         return sizeof("18446744073709551615") + 1; // room for a sign
+	}
+}
+
+
+static size_t unparseNumber(const Arg* arg, size_t i, char* out, size_t size)
+{
+	const void* items = argNumbers(arg, NULL, NULL);
+	int n;
+	switch (arg->type) {
+	case ARG_LONG:   n = snprintf(out, size, "%ld", ((const long*)items)[i]); break;
+	case ARG_DOUBLE: n = snprintf(out, size, "%.17g", ((const double*)items)[i]); break;
+	case ARG_INT8:   n = snprintf(out, size, "%d", ((const int8_t*)items)[i]); break;
+	case ARG_INT16:  n = snprintf(out, size, "%d", ((const int16_t*)items)[i]); break;
+	case ARG_INT32:  n = snprintf(out, size, "%ld", (long)((const int32_t*)items)[i]); break;
+	case ARG_UINT8:  n = snprintf(out, size, "%u", (unsigned)((const uint8_t*)items)[i]); break;
+	case ARG_UINT16: n = snprintf(out, size, "%u", (unsigned)((const uint16_t*)items)[i]); break;
+	case ARG_UINT32: n = snprintf(out, size, "%lu", (unsigned long)((const uint32_t*)items)[i]); break;
+	case ARG_UINT64: n = snprintf(out, size, "%llu", (unsigned long long)((const uint64_t*)items)[i]); break;
+	case ARG_FLOAT:  n = snprintf(out, size, "%.9g", ((const float*)items)[i]); break;
+	default:         n = 0; break;
+	}
+	// The parser only accepts '.', whatever LC_NUMERIC says
+	for (int j = 0; j < n; j++) {
+		if (out[j] == ',') out[j] = '.';
+	}
+	return (size_t)n + 1;
+}
+
+
+// A range kept as a generator goes back as one "first..last:step" token
+static size_t unparseSequence(const Arg* arg, char* out, size_t size)
+{
+	size_t last = arg->data.sequence.count - 1;
+	int n;
+	if (arg->type == ARG_LONG) {
+		n = snprintf(out, size, "%ld..%ld:%ld", argLong(arg, 0, 0), argLong(arg, 0, last), arg->data.sequence.step.l);
+	} else {
+		n = snprintf(out, size, "%.17g..%.17g:%.17g", argDouble(arg, 0, 0), argDouble(arg, 0, last), arg->data.sequence.step.d);
+	}
+	for (int j = 0; j < n; j++) {
+		if (out[j] == ',') out[j] = '.';
+	}
+	return (size_t)n + 1;
+}
+
+
+static size_t unparseCount(const Arg* arg)
+{
+	if (arg->type == ARG_BOOL) return 0;
+	return argCount(arg, 0);
+}
+
+
+// Renders arg into argv from *at, number text from *text. With argv NULL
+// it only adds up what it would need.
+static void unparseArg(const Arg* arg, char** argv, size_t* at, char** text, size_t* text_size)
+{
+	size_t count = unparseCount(arg);
+	if (arg->type == ARG_BOOL) {
+		if (!arg->data.exists) return;
+		if (argv != NULL) argv[*at] = (char*)arg->flag;
+		(*at)++;
+		return;
+	}
+
+	bool positional = argIsPositional(arg);
+	if (argIsSequence(arg)) {
+		if (!positional) {
+			if (argv != NULL) argv[*at] = (char*)arg->flag;
+			(*at)++;
+		}
+		if (argv != NULL) {
+			argv[*at] = *text;
+			*text += unparseSequence(arg, *text, 3 * unparseWidth(arg->type));
+		} else {
+			*text_size += 3 * unparseWidth(arg->type);
+		}
+		(*at)++;
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		// .nargs = x values per occurrence, which .append flags repeat
+		if (!positional && (i == 0 || (arg->nargs > 0 && i % arg->nargs == 0))) {
+			if (argv != NULL) argv[*at] = (char*)arg->flag;
+			(*at)++;
+		}
+		if (arg->type == ARG_STRING && arg->spans) {
+			// Spans are not terminated, they are copied into the text
+			ArgSpan value = argSpan(arg, 0, i);
+			if (argv != NULL) {
+				argv[*at] = *text;
+				memcpy(*text, value.data, value.size);
+				(*text)[value.size] = '\0';
+				*text += value.size + 1;
+			} else {
+				*text_size += value.size + 1;
+			}
+		} else if (arg->type == ARG_STRING) {
+			if (argv != NULL) argv[*at] = (char*)argStr(arg, 0, i);
+		} else if (arg->type == ARG_ENUM) {
+			if (argv != NULL) argv[*at] = (char*)arg->choices[arg->data.array_enum.items[i]];
+		} else if (argv != NULL) {
+			argv[*at] = *text;
+			*text += unparseNumber(arg, i, *text, unparseWidth(arg->type));
+		} else {
+			*text_size += unparseWidth(arg->type);
+		}
+		(*at)++;
+	}
+}
+
+
+bool argUnparse(const char* program, const Arg* args, size_t args_size, const size_t* handles, size_t handles_count, ArrayOfStrings* argv)
+{
+	if (handles == NULL) handles_count = args_size;
+
+	// Positionals first, they have to come before the first flag
+	size_t count     = (program != NULL);
+	size_t text_size = 0;
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t h = 0; h < handles_count; h++) {
+			const Arg* arg = &args[handles ? handles[h] : h];
+			if (argIsPositional(arg) != (pass == 0)) continue;
+			unparseArg(arg, NULL, &count, NULL, &text_size);
+		}
+	}
+
+	char** items = malloc((count + 1) * sizeof(char*) + text_size);
+	if (items == NULL) {
+		argLogError("Could not allocate an argv of %zu arguments", count);
+		return 1;
+	}
+
+	char*  text = (char*)(items + count + 1);
+	size_t at   = 0;
+	if (program != NULL) items[at++] = (char*)program;
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t h = 0; h < handles_count; h++) {
+			const Arg* arg = &args[handles ? handles[h] : h];
+			if (argIsPositional(arg) != (pass == 0)) continue;
+			unparseArg(arg, items, &at, &text, NULL);
+		}
+	}
+	items[count] = NULL;
+
+	argv->items    = items;
+	argv->count    = count;
+	argv->capacity = count;
+	return 0;
+}
@@ -0,0 +1,175 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// argParseContextParse must not allocate once its buffer has seen the
+// input shape, and argParseFixed never: malloc and friends are interposed
+// and counted while those parses run. Needs glibc for the real allocator,
+// the test is skipped elsewhere.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argparse.h"
+
+#define SKIPPED   77
+#define PARSES    100
+#define LIST_SIZE 200
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void  __libc_free(void* ptr);
+
+static bool   counting;
+static size_t allocations;
+
+void* malloc(size_t size)
+{
+	if (counting) allocations++;
+	return __libc_malloc(size);
+}
+
+
+void* calloc(size_t count, size_t size)
+{
+	if (counting) allocations++;
+	return __libc_calloc(count, size);
+}
+
+
+void* realloc(void* ptr, size_t size)
+{
+	if (counting) allocations++;
+	return __libc_realloc(ptr, size);
+}
+
+
+void free(void* ptr)
+{
+	__libc_free(ptr);
+}
+
+
+static const char* modes[] = { "fast", "safe", "debug", NULL };
+
+// Same shape on every call, the values change with seed
+static int buildArgv(char** argv, char storage[][32], int seed)
+{
+	int argc = 0;
+	argv[argc++] = "context_alloc";
+	snprintf(storage[argc], 32, "input%d.txt", seed);
+	argv[argc] = storage[argc]; argc++;
+	argv[argc++] = "--mode";
+	argv[argc++] = (char*)modes[seed % 3];
+	argv[argc++] = "--name";
+	snprintf(storage[argc], 32, "name-%d", seed);
+	argv[argc] = storage[argc]; argc++;
+	argv[argc++] = "--ratio";
+	snprintf(storage[argc], 32, "%d.5", seed);
+	argv[argc] = storage[argc]; argc++;
+	argv[argc++] = "--verbose";
+	argv[argc++] = "--tag";
+	argv[argc++] = seed % 2 ? "red" : "blue";
+	argv[argc++] = "--tag";
+	argv[argc++] = "green";
+	argv[argc++] = "--ids";
+	for (int i = 0; i < LIST_SIZE; i++) {
+		snprintf(storage[argc], 32, "%d", seed * LIST_SIZE + i);
+		argv[argc] = storage[argc]; argc++;
+	}
+	argv[argc] = NULL;
+	return argc;
+}
+
+
+static void declare(Arg* args)
+{
+	Arg declared[] = {
+		{ .flag = "input",     .type = ARG_STRING, .nargs = 1 },
+		{ .flag = "--mode",    .type = ARG_ENUM, .choices = modes },
+		{ .flag = "--name",    .type = ARG_STRING, .nargs = 1 },
+		{ .flag = "--ratio",   .type = ARG_DOUBLE },
+		{ .flag = "--verbose", .type = ARG_BOOL },
+		{ .flag = "--tag",     .type = ARG_STRING, .intern = true, .append = true },
+		{ .flag = "--ids",     .type = ARG_LONG },
+	};
+	memcpy(args, declared, sizeof(declared));
+}
+
+#define ARGS 7
+
+
+int main(void)
+{
+	static char storage[LIST_SIZE + 32][32];
+	char* argv[LIST_SIZE + 32];
+	Arg   args[ARGS];
+
+	// Small enough for --ids to reach the conversion threads in a heap parse
+	argSetParallelConversion(LIST_SIZE / 2, 4);
+
+	// First, before any parse could have started the conversion threads
+	static char fixed[ARG_PARSE_FIXED_SIZE(LIST_SIZE + 32, ARGS)];
+	int failed = 0;
+	int argc   = buildArgv(argv, storage, 7);
+	declare(args);
+	allocations = 0;
+	counting    = true;
+	argParseFixed(argc, argv, args, ARGS, fixed, sizeof(fixed));
+	counting    = false;
+	if (allocations != 0) {
+		fprintf(stderr, "argParseFixed allocated %zu times\n", allocations);
+		failed = 1;
+	}
+
+	ArgParseContext ctx = {0};
+	for (int seed = 0; seed < PARSES; seed++) {
+		argc = buildArgv(argv, storage, seed);
+		declare(args);
+		allocations = 0;
+		counting    = seed > 0;
+		argParseContextParse(&ctx, argc, argv, args, ARGS);
+		counting    = false;
+
+		if (allocations != 0) {
+			fprintf(stderr, "parse %d allocated %zu times\n", seed + 1, allocations);
+			failed = 1;
+		}
+		if (argLong(args, 6, LIST_SIZE - 1) != (long)(seed * LIST_SIZE + LIST_SIZE - 1) ||
+		    strcmp(argStr(args, 2, 0), storage[5])) {
+			fprintf(stderr, "parse %d returned wrong values\n", seed + 1);
+			failed = 1;
+		}
+	}
+	argParseContextFree(&ctx);
+	if (!failed) printf("argParseFixed and %d context parses, no allocation after the first\n", PARSES);
+	return failed;
+}
+#else
+int main(void)
+{
+	puts("interposing malloc needs glibc");
+	return SKIPPED;
+}
+#endif
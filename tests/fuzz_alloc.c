@@ -0,0 +1,100 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fuzz_alloc.h"
+
+// Blocks are kept on a doubly linked list through a header in front of
+// them, sized to keep the user part aligned like malloc does.
+typedef union Block {
+	struct {
+		union Block* prev;
+		union Block* next;
+	} link;
+	max_align_t align;
+} Block;
+
+static Block live = { .link = { &live, &live } };
+
+
+static void* track(Block* b)
+{
+	if (b == NULL) return NULL;
+	b->link.prev = live.link.prev;
+	b->link.next = &live;
+	live.link.prev->link.next = b;
+	live.link.prev = b;
+	return b + 1;
+}
+
+
+static Block* untrack(void* ptr)
+{
+	Block* b = (Block*)ptr - 1;
+	b->link.prev->link.next = b->link.next;
+	b->link.next->link.prev = b->link.prev;
+	return b;
+}
+
+
+void* fuzzMalloc(size_t size)
+{
+	if (size > SIZE_MAX - sizeof(Block)) return NULL;
+	return track(malloc(sizeof(Block) + size));
+}
+
+
+void* fuzzCalloc(size_t count, size_t size)
+{
+	if (size != 0 && count > (SIZE_MAX - sizeof(Block)) / size) return NULL;
+	void* p = fuzzMalloc(count * size);
+	if (p != NULL) memset(p, 0, count * size);
+	return p;
+}
+
+
+void* fuzzRealloc(void* ptr, size_t size)
+{
+	if (ptr == NULL) return fuzzMalloc(size);
+	if (size > SIZE_MAX - sizeof(Block)) return NULL;
+	Block* b = untrack(ptr);
+	Block* r = realloc(b, sizeof(Block) + size);
+	if (r == NULL) {
+		track(b);
+		return NULL;
+	}
+	return track(r);
+}
+
+
+void fuzzFree(void* ptr)
+{
+	if (ptr != NULL) free(untrack(ptr));
+}
+
+
+void fuzzReleaseAll(void)
+{
+	while (live.link.next != &live) fuzzFree(live.link.next + 1);
+}
@@ -0,0 +1,160 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// libFuzzer harness for tokenizeArguments, the parse entry points and
+// argBlobValidate. The input is checked as a blob, then split at NUL
+// bytes into argv. The library reports errors with exit(), so its sources
+// are built for this target with exit and the allocator redirected to
+// fuzz_alloc.c: a rejected input returns here and everything it allocated
+// is released before the next one.
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argparse.h"
+#include "argparse_internal.h"
+#include "fuzz_alloc.h"
+
+#define FUZZ_MAX_TOKENS 256
+
+static jmp_buf fuzz_exit;
+
+void argFuzzExit(int status)
+{
+	(void)status;
+	longjmp(fuzz_exit, 1);
+}
+
+
+static const char* modes[] = { "fast", "safe", "debug", NULL };
+
+static void declare(Arg* args)
+{
+	Arg declared[] = {
+		{ .flag = "input", .type = ARG_STRING, .nargs = 1 },
+		{ .flag = "rest",  .type = ARG_LONG },
+		{ .flag = "--s",   .type = ARG_STRING },
+		{ .flag = "--n",   .type = ARG_LONG, .nargs = 2 },
+		{ .flag = "--d",   .type = ARG_DOUBLE, .append = true, .range = true },
+		{ .flag = "--b",   .type = ARG_BOOL },
+		{ .flag = "--e",   .type = ARG_ENUM, .choices = modes },
+		{ .flag = "--i",   .type = ARG_STRING, .intern = true, .append = true },
+		{ .flag = "--u",   .type = ARG_UINT8 },
+		{ .flag = "--f",   .type = ARG_FLOAT, .required = true },
+	};
+	memcpy(args, declared, sizeof(declared));
+}
+
+#define FUZZ_ARGS 10
+
+
+// The raw input as an untrusted blob: once validated every accessor must
+// stay inside it.
+static void fuzzBlob(const uint8_t* data, size_t size)
+{
+	void* blob = fuzzAllocRaw(size > 0 ? size : 1);
+	memcpy(blob, data, size);
+	if (!argBlobValidate(blob, size)) return;
+
+	volatile size_t sink = 0;
+	for (size_t i = 0; i < argBlobArgsSize(blob); i++) {
+		sink += strlen(argBlobFlag(blob, i)) + argBlobExists(blob, i);
+		if (argBlobType(blob, i) == ARG_STRING) {
+			for (size_t j = 0; j < argBlobCount(blob, i); j++) sink += strlen(argBlobString(blob, i, j));
+		} else if (argTypeSize(argBlobType(blob, i)) > 0 && argBlobCount(blob, i) > 0) {
+			const uint8_t* values = argBlobValues(blob, i);
+			sink += values[argBlobCount(blob, i) * argTypeSize(argBlobType(blob, i)) - 1];
+		}
+	}
+}
+
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	fuzzBlob(data, size);
+
+	// NUL terminated copy, split at the NULs into argv
+	char* text = fuzzAllocRaw(size + 1);
+	memcpy(text, data, size);
+	text[size] = '\0';
+
+	char*     argv[FUZZ_MAX_TOKENS + 2];
+	ArgSpan   spans[FUZZ_MAX_TOKENS];
+	int       argc = 1;
+	argv[0] = "fuzz";
+	for (size_t at = 0; at < size && argc <= FUZZ_MAX_TOKENS; at += strlen(text + at) + 1) {
+		spans[argc - 1] = (ArgSpan){ text + at, strlen(text + at) };
+		argv[argc++] = text + at;
+	}
+	argv[argc] = NULL;
+
+	Arg args[FUZZ_ARGS];
+	ArgTokens tokens = {0};
+	tokenizeArguments(argc, argv, &tokens);
+	if (tokens.count != (size_t)argc - 1) abort();
+	ArgTokens reserved = { .items = fuzzAllocRaw(((size_t)argc + 1) * sizeof(ArgToken)), .capacity = (size_t)argc + 1 };
+	tokenizeArguments(argc, argv, &reserved);
+	if (reserved.count != tokens.count) abort();
+	for (size_t i = 0; i < tokens.count; i++) {
+		// Field by field, the padding of the tokens is indeterminate
+		if (tokens.items[i].type != reserved.items[i].type || tokens.items[i].data != reserved.items[i].data) abort();
+	}
+
+	// "__complete" prints and exits, which is covered by the other words
+	if (argc > 1 && !strcmp(argv[1], "__complete")) goto done;
+
+	declare(args);
+	if (!setjmp(fuzz_exit)) argParse(argc, argv, args, FUZZ_ARGS);
+
+	static char fixed[ARG_PARSE_FIXED_SIZE(FUZZ_MAX_TOKENS + 1, FUZZ_ARGS)];
+	declare(args);
+	if (!setjmp(fuzz_exit)) argParseFixed(argc, argv, args, FUZZ_ARGS, fixed, sizeof(fixed));
+
+	declare(args);
+	ArgLeftovers leftovers;
+	if (!setjmp(fuzz_exit)) argParseKnown(argc, argv, args, FUZZ_ARGS, &leftovers);
+
+	declare(args);
+	args[4].range  = false; // argParseSpans rejects both
+	args[7].intern = false;
+	if (!setjmp(fuzz_exit) && !argParseSpans(spans, (size_t)argc - 1, args, FUZZ_ARGS)) {
+		// Span results copied as strings
+		ArgSnapshot* snapshot = argSnapshotCreate(args, FUZZ_ARGS);
+		if (snapshot == NULL || argCount(snapshot->args, 0) != argCount(args, 0)) abort();
+		argSnapshotFree(snapshot);
+		size_t blob_size = argBlobSize(args, FUZZ_ARGS);
+		void*  blob      = fuzzAllocRaw(blob_size);
+		if (argBlobWrite(args, FUZZ_ARGS, blob, blob_size) != blob_size || !argBlobValidate(blob, blob_size)) abort();
+		ArrayOfStrings unparsed;
+		if (argUnparse("fuzz", args, FUZZ_ARGS, NULL, 0, &unparsed)) abort();
+	}
+
+	// The whole input as one command string, up to its first NUL
+	declare(args);
+	if (!setjmp(fuzz_exit)) argParseString(text, args, FUZZ_ARGS);
+
+done:
+	fuzzReleaseAll();
+	return 0;
+}
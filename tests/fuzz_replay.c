@@ -0,0 +1,143 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Runs the fuzz harness without libFuzzer: on the files given as
+// arguments (e.g. a corpus or a crash), or on inputs generated from a
+// fixed seed when there are none: command lines from a vocabulary, and
+// valid argument blobs with corrupted header and entry fields. The
+// generated run is the ctest smoke test of the harness.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "argparse.h"
+
+#define REPLAY_INPUTS 20000
+#define REPLAY_BLOBS  5000
+#define REPLAY_SIZE   512
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static const char* words[] = {
+	"--s", "--n", "--d", "--b", "--e", "--i", "--u", "--f", "--x", "--",
+	"--help", "-", "-1", "0", "255", "256", "1e308", "1e309", "-0", "nan",
+	"inf", "1..5", "0..0.3:0.1", "5..1:2", "1..", "0x10", "1.5", "3.4028236e38", "9223372036854775808", "fast",
+	"safe", "debug", "fas", "a b", "\"quoted words\"", "'single'", "\\",
+	"\"", "x\\\"y", "", "input", "rest",
+};
+
+
+static uint32_t next(uint32_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+
+static void replayBlobs(uint32_t* state)
+{
+	static const char* modes[] = { "fast", "safe", NULL };
+	char* argv[] = { "replay", "in.txt", "--n", "1", "2", "--e", "safe", "--b", "--s", "x", "yz", NULL };
+	Arg args[] = {
+		{ .flag = "input", .type = ARG_STRING, .nargs = 1 },
+		{ .flag = "--n",   .type = ARG_LONG },
+		{ .flag = "--e",   .type = ARG_ENUM, .choices = modes },
+		{ .flag = "--b",   .type = ARG_BOOL },
+		{ .flag = "--s",   .type = ARG_STRING },
+	};
+	argParse(11, argv, args, 5);
+
+	// The harness releases what the library allocated, keep a copy
+	size_t    size  = argBlobSize(args, 5);
+	uint64_t* valid = malloc(size);
+	uint64_t* blob  = malloc(size);
+	if (valid == NULL || blob == NULL || argBlobWrite(args, 5, valid, size) != size) abort();
+
+	const uint64_t values[] = { 0, 1, 7, 8, 24, size - 1, size, size + 8, UINT32_MAX, UINT64_MAX / 8, UINT64_MAX };
+	for (int input = 0; input < REPLAY_BLOBS; input++) {
+		memcpy(blob, valid, size);
+		// The header and the entry table are the first words
+		size_t fields = (sizeof(ArgBlobHeader) + 5 * sizeof(ArgBlobEntry)) / sizeof(uint64_t);
+		for (uint32_t m = next(state) % 3; m < 3; m++) {
+			blob[next(state) % fields] = values[next(state) % (sizeof(values) / sizeof(values[0]))];
+		}
+		// Sometimes cut short, a header can claim less than the buffer holds
+		size_t cut = (next(state) % 4 == 0) ? next(state) % size : size;
+		LLVMFuzzerTestOneInput((const uint8_t*)blob, cut);
+	}
+	free(valid);
+	free(blob);
+}
+
+
+static int replayFile(const char* path)
+{
+	FILE* f = fopen(path, "rb");
+	if (f == NULL) {
+		perror(path);
+		return 1;
+	}
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	uint8_t* data = malloc(size > 0 ? (size_t)size : 1);
+	size_t got = fread(data, 1, (size_t)size, f);
+	fclose(f);
+	LLVMFuzzerTestOneInput(data, got);
+	free(data);
+	return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+	if (argc > 1) {
+		int failed = 0;
+		for (int i = 1; i < argc; i++) failed |= replayFile(argv[i]);
+		return failed;
+	}
+
+	uint32_t state = 0x2545f491;
+	uint8_t  data[REPLAY_SIZE];
+	for (int input = 0; input < REPLAY_INPUTS; input++) {
+		size_t size  = 0;
+		size_t count = next(&state) % 24;
+		for (size_t w = 0; w < count; w++) {
+			const char* word = words[next(&state) % (sizeof(words) / sizeof(words[0]))];
+			size_t n = strlen(word);
+			if (size + n + 1 > sizeof(data)) break;
+			memcpy(data + size, word, n);
+			size += n;
+			// Mostly token separators, sometimes glued or bit flipped bytes
+			uint32_t r = next(&state) % 16;
+			if (r == 0 && size > 0) data[size - 1] ^= (uint8_t)(1 << (next(&state) % 8));
+			if (r != 1) data[size++] = (r == 2) ? ' ' : '\0';
+		}
+		LLVMFuzzerTestOneInput(data, size);
+	}
+	replayBlobs(&state);
+	printf("%d generated inputs passed\n", REPLAY_INPUTS + REPLAY_BLOBS);
+	return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Differential test of ArgParseState: after every random edit the state
+// must report no error exactly when argParse accepts the same tokens.
+// The library is the fuzz build, whose exit() returns here.
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "argparse.h"
+#include "fuzz_alloc.h"
+
+#define DIFF_EDITS      20000
+#define DIFF_MAX_TOKENS 24
+
+static jmp_buf diff_exit;
+
+void argFuzzExit(int status)
+{
+	(void)status;
+	longjmp(diff_exit, 1);
+}
+
+
+static const char* modes[] = { "fast", "safe", NULL };
+
+// Typed positionals: a fixed ARG_LONG and a variadic ARG_DOUBLE
+static const Arg declared[] = {
+	{ .flag = "count", .type = ARG_LONG, .nargs = 1 },
+	{ .flag = "rest",  .type = ARG_DOUBLE },
+	{ .flag = "--r",   .type = ARG_LONG, .range = true },
+	{ .flag = "--v",   .type = ARG_BOOL },
+	{ .flag = "--s",   .type = ARG_STRING, .nargs = 1 },
+	{ .flag = "--e",   .type = ARG_ENUM, .choices = modes, .append = true },
+};
+
+#define DIFF_ARGS (sizeof(declared) / sizeof(declared[0]))
+
+static const char* words[] = {
+	"1", "-3", "0.5", "1e3", "x", "fast", "nope", "1..3", "",
+	"--r", "--v", "--s", "--e", "--zz",
+};
+
+#define DIFF_WORDS (sizeof(words) / sizeof(words[0]))
+
+
+static uint32_t next(uint32_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+
+static bool parseAccepts(const ArgParseState* state)
+{
+	char* argv[DIFF_MAX_TOKENS + 8];
+	int   argc = 0;
+	argv[argc++] = "diff";
+	for (size_t i = 0; i < argParseStateCount(state); i++) argv[argc++] = (char*)argParseStateToken(state, i);
+	argv[argc] = NULL;
+
+	Arg args[DIFF_ARGS];
+	memcpy(args, declared, sizeof(declared));
+	bool accepted = false;
+	if (!setjmp(diff_exit)) accepted = !argParse(argc, argv, args, DIFF_ARGS);
+	return accepted;
+}
+
+
+int main(void)
+{
+	// argParse logs every rejected line
+	if (freopen("/dev/null", "w", stderr) == NULL) return 1;
+
+	uint32_t seed = 0x9e3779b9;
+	int failed = 0;
+	for (int round = 0; round < 10 && !failed; round++) {
+		ArgParseState state;
+		if (argParseStateInit(&state, declared, DIFF_ARGS)) return 1;
+		for (int edit = 0; edit < DIFF_EDITS / 10; edit++) {
+			size_t count    = argParseStateCount(&state);
+			size_t position = next(&seed) % (count + 1);
+			size_t remove   = next(&seed) % 3;
+			if (remove > count - position) remove = count - position;
+			size_t insert   = next(&seed) % 3;
+			if (count - remove + insert > DIFF_MAX_TOKENS) insert = 0;
+
+			const char* tokens[3];
+			for (size_t i = 0; i < insert; i++) tokens[i] = words[next(&seed) % DIFF_WORDS];
+			argParseStateEdit(&state, position, remove, tokens, insert);
+
+			bool valid = argParseStateErrorCount(&state) == 0;
+			if (valid != parseAccepts(&state)) {
+				printf("state %s, argParse %s:", valid ? "valid" : "invalid", valid ? "rejects" : "accepts");
+				for (size_t i = 0; i < argParseStateCount(&state); i++) printf(" '%s'", argParseStateToken(&state, i));
+				printf("\n");
+				failed = 1;
+				break;
+			}
+		}
+		// Also drops what the rejected parses left behind
+		argParseStateFree(&state);
+		fuzzReleaseAll();
+	}
+	if (!failed) printf("%d edits agree with argParse\n", DIFF_EDITS);
+	return failed;
+}
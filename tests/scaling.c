@@ -0,0 +1,320 @@
+// Copyright 2025 Charalampos Eleftheriadis <charelevresearch@gmail.com>
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+// Complexity regression: every phase runs on adversarial inputs of growing
+// size n, and the slope of log(time) over log(n log n) must stay close to
+// 1. A quadratic phase has a slope near 2 at these sizes.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "argparse.h"
+#include "argparse_internal.h"
+
+#define MIN_SIZE    4096
+#define SIZES       6
+#define MIN_SECONDS 0.01
+#define MAX_SLOPE   1.4
+
+typedef struct {
+	int            argc;
+	char**         argv;
+	Arg*           args;
+	size_t         args_size;
+	ArgTokens      tokens;
+	Args           parsed;
+	ArrayOfStrings values;
+	char*          text;
+	char*          scratch;
+	size_t         text_size;
+	ArgSpan*       spans;
+	size_t         spans_count;
+} Input;
+
+typedef struct {
+	const char* name;
+	void (*build)(Input* in, size_t n);
+	void (*phase)(Input* in);
+} Case;
+
+
+static double now(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+
+static void* xcalloc(size_t count, size_t size)
+{
+	void* p = calloc(count ? count : 1, size);
+	if (p == NULL) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	return p;
+}
+
+
+static char* format(const char* fmt, size_t i)
+{
+	char* s = xcalloc(32, 1);
+	snprintf(s, 32, fmt, i);
+	return s;
+}
+
+
+// Frees the results owned by the caller so repeated parses do not pile up
+static void resetResults(Input* in)
+{
+	for (size_t i = 0; i < in->args_size; i++) {
+		Arg* arg = &in->args[i];
+		if (arg->type == ARG_STRING && arg->data.array_string.capacity > 0) free(arg->data.array_string.items);
+		if (arg->type == ARG_LONG && arg->data.array_long.capacity > 0) free(arg->data.array_long.items);
+		memset(&arg->data, 0, sizeof(arg->data));
+	}
+}
+
+
+// argv of n distinct flags with one value each, declared in the opposite
+// order so the lookups can not walk both lists in step.
+static void buildDistinctFlags(Input* in, size_t n)
+{
+	in->argc      = (int)(2 * n + 1);
+	in->argv      = xcalloc((size_t)in->argc + 1, sizeof(char*));
+	in->args_size = n;
+	in->args      = xcalloc(n, sizeof(Arg));
+	in->argv[0]   = "scaling";
+	for (size_t i = 0; i < n; i++) {
+		in->argv[2 * i + 1] = format("--flag%zu", i);
+		in->argv[2 * i + 2] = format("value%zu", i);
+		in->args[n - 1 - i] = (Arg){ .type = ARG_STRING, .flag = in->argv[2 * i + 1], .nargs = 1 };
+	}
+
+	in->tokens.items    = xcalloc((size_t)in->argc, sizeof(ArgToken));
+	in->tokens.capacity = (size_t)in->argc;
+	tokenizeArguments(in->argc, in->argv, &in->tokens);
+	in->parsed.items    = xcalloc(n + 1, sizeof(Arg));
+	in->parsed.capacity = n + 1;
+	in->values.items    = xcalloc(n + 1, sizeof(char*));
+	in->values.capacity = n + 1;
+	parseArguments(&in->tokens, &in->parsed, &in->values);
+}
+
+
+static void buildBools(Input* in, size_t n)
+{
+	in->argc      = (int)(n + 1);
+	in->argv      = xcalloc(n + 2, sizeof(char*));
+	in->args_size = n;
+	in->args      = xcalloc(n, sizeof(Arg));
+	in->argv[0]   = "scaling";
+	for (size_t i = 0; i < n; i++) {
+		in->argv[i + 1] = format("--b%zu", i);
+		in->args[i] = (Arg){ .type = ARG_BOOL, .flag = in->argv[i + 1] };
+	}
+}
+
+
+static void buildLongValues(Input* in, size_t n)
+{
+	in->argc      = (int)(n + 2);
+	in->argv      = xcalloc(n + 3, sizeof(char*));
+	in->args_size = 1;
+	in->args      = xcalloc(1, sizeof(Arg));
+	in->argv[0]   = "scaling";
+	in->argv[1]   = "--numbers";
+	for (size_t i = 0; i < n; i++) in->argv[i + 2] = format("%zu", i * 7919);
+	in->args[0] = (Arg){ .type = ARG_LONG, .flag = "--numbers" };
+}
+
+
+// One .append flag repeated n times
+static void buildRepeated(Input* in, size_t n)
+{
+	in->argc      = (int)(2 * n + 1);
+	in->argv      = xcalloc(2 * n + 2, sizeof(char*));
+	in->args_size = 1;
+	in->args      = xcalloc(1, sizeof(Arg));
+	in->argv[0]   = "scaling";
+	for (size_t i = 0; i < n; i++) {
+		in->argv[2 * i + 1] = "--tag";
+		in->argv[2 * i + 2] = format("t%zu", i % 64);
+	}
+	in->args[0] = (Arg){ .type = ARG_STRING, .flag = "--tag", .append = true };
+}
+
+
+// A single value n bytes long
+static void buildLongToken(Input* in, size_t n)
+{
+	char* value = xcalloc(n + 1, 1);
+	memset(value, 'x', n);
+	in->argc      = 3;
+	in->argv      = xcalloc(4, sizeof(char*));
+	in->args_size = 1;
+	in->args      = xcalloc(1, sizeof(Arg));
+	in->argv[0]   = "scaling";
+	in->argv[1]   = "--text";
+	in->argv[2]   = value;
+	in->args[0] = (Arg){ .type = ARG_STRING, .flag = "--text", .nargs = 1 };
+}
+
+
+// One command string of n quoted words, and the same words as spans
+static void buildText(Input* in, size_t n)
+{
+	buildLongValues(in, n);
+	in->args[0].type = ARG_STRING;
+	in->text_size = 0;
+	for (int i = 1; i < in->argc; i++) in->text_size += strlen(in->argv[i]) + 3;
+	in->text    = xcalloc(in->text_size + 1, 1);
+	in->scratch = xcalloc(in->text_size + 1, 1);
+	in->spans   = xcalloc((size_t)in->argc, sizeof(ArgSpan));
+	char* at = in->text;
+	for (int i = 1; i < in->argc; i++) {
+		at += sprintf(at, "\"%s\" ", in->argv[i]);
+		in->spans[in->spans_count++] = (ArgSpan){ in->argv[i], strlen(in->argv[i]) };
+	}
+}
+
+
+static void phaseTokenize(Input* in)
+{
+	in->tokens.count = 0;
+	tokenizeArguments(in->argc, in->argv, &in->tokens);
+}
+
+
+static void phaseParse(Input* in)
+{
+	in->parsed.count = 0;
+	in->values.count = 0;
+	parseArguments(&in->tokens, &in->parsed, &in->values);
+}
+
+
+static void phaseCheck(Input* in)
+{
+	checkParsedArguments(&in->parsed, in->args, in->args_size);
+}
+
+
+static void phaseArgParse(Input* in)
+{
+	argParse(in->argc, in->argv, in->args, in->args_size);
+	resetResults(in);
+}
+
+
+static void phaseArgParseString(Input* in)
+{
+	memcpy(in->scratch, in->text, in->text_size + 1);
+	argParseString(in->scratch, in->args, in->args_size);
+	resetResults(in);
+}
+
+
+static void phaseArgParseSpans(Input* in)
+{
+	argParseSpans(in->spans, in->spans_count, in->args, in->args_size);
+	free(in->args[0].data.array_span.items);
+	memset(&in->args[0].data, 0, sizeof(in->args[0].data));
+}
+
+
+static const Case cases[] = {
+	{ "tokenize distinct flags",      buildDistinctFlags, phaseTokenize       },
+	{ "group distinct flags",         buildDistinctFlags, phaseParse          },
+	{ "check distinct flags",         buildDistinctFlags, phaseCheck          },
+	{ "argParse distinct flags",      buildDistinctFlags, phaseArgParse       },
+	{ "argParse bool flags",          buildBools,         phaseArgParse       },
+	{ "argParse long values",         buildLongValues,    phaseArgParse       },
+	{ "argParse repeated flag",       buildRepeated,      phaseArgParse       },
+	{ "argParse long token",          buildLongToken,     phaseArgParse       },
+	{ "argParseString quoted words",  buildText,          phaseArgParseString },
+	{ "argParseSpans words",          buildText,          phaseArgParseSpans  },
+};
+
+
+// Seconds per call: calls are repeated until they take MIN_SECONDS, and
+// the best of three such rounds is kept.
+static double measure(const Case* c, Input* in)
+{
+	double best = INFINITY;
+	for (int round = 0; round < 3; round++) {
+		size_t calls = 0;
+		double start = now();
+		double elapsed;
+		do {
+			c->phase(in);
+			calls++;
+			elapsed = now() - start;
+		} while (elapsed < MIN_SECONDS);
+		if (elapsed / (double)calls < best) best = elapsed / (double)calls;
+	}
+	return best;
+}
+
+
+// Least squares slope of y over x
+static double slope(const double* x, const double* y, size_t count)
+{
+	double mx = 0, my = 0;
+	for (size_t i = 0; i < count; i++) {
+		mx += x[i] / (double)count;
+		my += y[i] / (double)count;
+	}
+	double sxy = 0, sxx = 0;
+	for (size_t i = 0; i < count; i++) {
+		sxy += (x[i] - mx) * (y[i] - my);
+		sxx += (x[i] - mx) * (x[i] - mx);
+	}
+	return sxy / sxx;
+}
+
+
+int main(void)
+{
+	int failed = 0;
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		double x[SIZES], y[SIZES];
+		printf("%-30s", cases[c].name);
+		for (size_t s = 0; s < SIZES; s++) {
+			size_t n = (size_t)MIN_SIZE << s;
+			Input in = {0};
+			cases[c].build(&in, n);
+			double t = measure(&cases[c], &in);
+			x[s] = log((double)n * log2((double)n));
+			y[s] = log(t);
+			printf(" %9.1fus", t * 1e6);
+			// The inputs are small next to the measured work, they are not freed
+		}
+		double k = slope(x, y, SIZES);
+		printf("  slope %.2f%s\n", k, k > MAX_SLOPE ? "  FAILED" : "");
+		if (k > MAX_SLOPE) failed = 1;
+	}
+	return failed;
+}